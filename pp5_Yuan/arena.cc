@@ -0,0 +1,133 @@
+/* File: arena.cc
+ * --------------
+ * Implementation of Arena, and of the operators new and delete of the
+ * process.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <new>
+#include "stats.h"
+
+thread_local Arena *Arena::current = NULL;
+
+/*
+ * The header of a block of operator new, of the size of the alignment of
+ * malloc so that the block keeps it.
+ */
+struct BlockHeader {
+    Arena *arena;                   // NULL for a block of malloc.
+    size_t unused;
+};
+
+static void *NewBlock(size_t size) {
+    if (Stats::countAllocations.load(std::memory_order_relaxed))
+        Stats::allocated.fetch_add(size, std::memory_order_relaxed);
+    Arena *arena = Arena::current;
+    size += sizeof(BlockHeader);
+    BlockHeader *h = (BlockHeader *)(arena ? arena->Allocate(size)
+                                           : malloc(size));
+    if (!h) return NULL;
+    h->arena = arena;
+    return h + 1;
+}
+
+static void DeleteBlock(void *p) {
+    if (!p) return;
+    BlockHeader *h = (BlockHeader *)p - 1;
+    // the blocks of an arena are freed with it.
+    if (!h->arena) free(h);
+}
+
+/*
+ * The default operators new[] and delete[] go through these.
+ */
+void *operator new(size_t size) {
+    void *p = NewBlock(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return NewBlock(size);
+}
+
+void operator delete(void *p) noexcept {
+    DeleteBlock(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    DeleteBlock(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    DeleteBlock(p);
+}
+
+Arena::Arena() : refs(1) {
+    chunks = NULL;
+    next = end = NULL;
+    size = 0;
+}
+
+Arena::~Arena() {
+    while (chunks) {
+        Chunk *c = chunks;
+        chunks = c->next;
+        free(c);
+    }
+}
+
+/*
+ * A chunk of room for at least n bytes, which is linked in by the caller.
+ */
+Arena::Chunk *Arena::NewChunk(size_t n) {
+    size_t bytes = sizeof(Chunk) + (n > ChunkSize ? n : ChunkSize);
+    Chunk *c = (Chunk *)malloc(bytes);
+    if (!c) return NULL;
+    c->size = bytes;
+    size += bytes;
+    return c;
+}
+
+void *Arena::Allocate(size_t n) {
+    const size_t align = sizeof(BlockHeader);
+    n = (n + align - 1) & ~(align - 1);
+    std::lock_guard<std::mutex> guard(lock);
+    if (n > ChunkSize / 4) {
+        // a large block has a chunk of its own, behind the newest one.
+        Chunk *c = NewChunk(n);
+        if (!c) return NULL;
+        if (chunks) {
+            c->next = chunks->next;
+            chunks->next = c;
+        } else {
+            c->next = NULL;
+            chunks = c;
+            next = end = (char *)(c + 1) + n;
+        }
+        return c + 1;
+    }
+    if ((size_t)(end - next) < n) {
+        Chunk *c = NewChunk(n);
+        if (!c) return NULL;
+        c->next = chunks;
+        chunks = c;
+        next = (char *)(c + 1);
+        end = (char *)c + c->size;
+    }
+    void *p = next;
+    next += n;
+    return p;
+}
+
+size_t Arena::Size() {
+    std::lock_guard<std::mutex> guard(lock);
+    return size;
+}
+
+void Arena::Release() {
+    if (--refs == 0) delete this;
+}
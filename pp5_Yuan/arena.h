@@ -0,0 +1,71 @@
+/* File: arena.h
+ * -------------
+ * An Arena holds the memory of one compilation of the compile server (see
+ * server.h), so that it is freed at once. The AST, the symbol and type
+ * tables, the Tac and the input are many small objects pointing to each
+ * other, which the compiler never frees one by one.
+ *
+ * While Arena::current is set on a thread, operator new allocates from
+ * that arena, and operator delete of a block of an arena does nothing.
+ * ParallelFor passes the arena of the calling thread to its workers. Each
+ * block of operator new starts with a header which tells the arena of the
+ * block, or none for a block of malloc.
+ *
+ * An arena is freed when its last reference is released. The server holds
+ * one while it serves the request, and the UnitCache one for each arena
+ * which holds the code of a cached function, since that code shares its
+ * labels, temps and locations with the rest of its compilation.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_arena
+#define _H_arena
+
+#include <stddef.h>
+#include <atomic>
+#include <mutex>
+
+class Arena
+{
+  protected:
+    struct Chunk {
+        Chunk *next;
+        size_t size;
+    };
+    static const size_t ChunkSize = 64 << 10;
+
+    Chunk *chunks;                  // the newest first.
+    char *next, *end;               // the room left in the newest chunk.
+    size_t size;                    // the bytes of all the chunks.
+    std::mutex lock;                // the workers of ParallelFor share it.
+    std::atomic<int> refs;
+
+    ~Arena();
+    Chunk *NewChunk(size_t n);
+
+  public:
+    // the arena of the compilation running on the current thread, or NULL.
+    static thread_local Arena *current;
+
+    // constructor, with one reference.
+    Arena();
+    // n bytes aligned for any object, NULL if out of memory. Thread-safe.
+    void *Allocate(size_t n);
+    size_t Size();
+    void Retain() { refs++; }
+    // frees the arena with the last reference.
+    void Release();
+
+    // allocates from malloc in a scope, for the data which outlives the
+    // compilation, such as that of the UnitCache.
+    class Suspend
+    {
+        Arena *saved;
+      public:
+        Suspend() { saved = current; current = NULL; }
+        ~Suspend() { current = saved; }
+    };
+};
+
+#endif
@@ -5,23 +5,27 @@
  */
 
 #include <stdio.h>  // printf
-#include <string.h> // strdup
+#include <string.h>
 #include "ast.h"
 #include "ast_decl.h"
 #include "ast_type.h"
 #include "errors.h"
-
-// the global code generator class.
-CodeGenerator *CG = new CodeGenerator();
+#include "stats.h"
 
 Node::Node(yyltype loc) {
+    Stats::Count(Stats::AstNodes);
     location = new yyltype(loc);
     parent = NULL;
+    expr_type = NULL;
+    emit_loc = NULL;
 }
 
 Node::Node() {
+    Stats::Count(Stats::AstNodes);
     location = NULL;
     parent = NULL;
+    expr_type = NULL;
+    emit_loc = NULL;
 }
 
 /* The Print method is used to print the parse tree nodes.
@@ -45,7 +49,8 @@ void Node::Print(int indentLevel, const char *label) {
 }
 
 Identifier::Identifier(yyltype loc, const char *n) : Node(loc) {
-    name = strdup(n);
+    name = CopyString(n);
+    decl = NULL;
 }
 
 void Identifier::PrintChildren(int indentLevel) {
@@ -54,7 +59,7 @@ void Identifier::PrintChildren(int indentLevel) {
 }
 
 void Identifier::CheckDecl() {
-    Decl *d = symtab->Lookup(this);
+    Decl *d = ctx->symtab->Lookup(this);
     if (d == NULL) {
         ReportError::IdentifierNotDeclared(this, LookingForVariable);
     } else {
@@ -80,7 +85,7 @@ void Identifier::Emit() {
 }
 
 void Identifier::AddPrefix(const char *prefix) {
-    char *s = (char *)malloc(strlen(name) + strlen(prefix) + 1);
+    char *s = new char[strlen(name) + strlen(prefix) + 1];
     sprintf(s, "%s%s", prefix, name);
     name = s;
 }
@@ -47,9 +47,7 @@
 #include "location.h"
 #include "errors.h"
 #include "codegen.h"
-
-// the global code generator class.
-extern CodeGenerator *CG;
+#include "context.h"
 
 class Node
 {
@@ -65,7 +63,7 @@ class Node
     Node();
     // utilities.
     yyltype *GetLocation()   { return location; }
-    void SetParent(Node *p)  { parent = p; }
+    virtual void SetParent(Node *p) { parent = p; }
     Node *GetParent()        { return parent; }
     // print stuff.
     virtual const char *GetPrintNameForNode() = 0;
@@ -10,11 +10,14 @@
 #include "ast_type.h"
 #include "list.h"
 #include "errors.h"
+#include "unitcache.h"
+#include "trace.h"
 
 Decl::Decl(Identifier *n) : Node(*n->GetLocation()) {
     Assert(n != NULL);
     (id=n)->SetParent(this);
     idx = -1;
+    imported = false;
     expr_type = NULL;
 }
 
@@ -35,11 +38,11 @@ void VarDecl::PrintChildren(int indentLevel) {
 }
 
 void VarDecl::BuildST() {
-    if (symtab->LocalLookup(this->GetId())) {
-        Decl *d = symtab->Lookup(this->GetId());
+    if (ctx->symtab->LocalLookup(this->GetId())) {
+        Decl *d = ctx->symtab->Lookup(this->GetId());
         ReportError::DeclConflict(this, d);
     } else {
-        idx = symtab->InsertSymbol(this);
+        idx = ctx->symtab->InsertSymbol(this);
         id->SetDecl(this);
     }
 }
@@ -65,7 +68,7 @@ void VarDecl::Check(checkT c) {
 
 void VarDecl::AssignOffset() {
     if (this->IsGlobal()) {
-        emit_loc = new Location(gpRelative, CG->GetNextGlobalLoc(),
+        emit_loc = new Location(gpRelative, ctx->cg->GetNextGlobalLoc(),
                 id->GetIdName());
     }
 }
@@ -73,19 +76,19 @@ void VarDecl::AssignOffset() {
 void VarDecl::AssignMemberOffset(bool inClass, int offset) {
     class_member_ofst = offset;
     // set location for var members of class.
-    emit_loc = new Location(fpRelative, offset, id->GetIdName(), CG->ThisPtr);
+    emit_loc = new Location(fpRelative, offset, id->GetIdName(),
+            CodeGenerator::ThisPtr);
 }
 
 void VarDecl::Emit() {
     if (type == Type::doubleType) {
         ReportError::Formatted(this->GetLocation(),
                 "Double type is not supported by compiler back end yet.");
-        Assert(0);
     }
 
     if (!emit_loc) {
         // some auto variables.
-        emit_loc = new Location(fpRelative, CG->GetNextLocalLoc(),
+        emit_loc = new Location(fpRelative, ctx->cg->GetNextLocalLoc(),
                 id->GetIdName());
     }
 }
@@ -98,8 +101,10 @@ ClassDecl::ClassDecl(Identifier *n, NamedType *ex, List<NamedType*> *imp,
     if (extends) extends->SetParent(this);
     (implements=imp)->SetParentAll(this);
     (members=m)->SetParentAll(this);
-    instance_size = 4;
-    vtable_size = 0;
+    layout = NULL;
+    pre_num = post_num = -1;
+    itfc_set = NULL;
+    children = new List<ClassDecl*>;
 }
 
 void ClassDecl::PrintChildren(int indentLevel) {
@@ -113,26 +118,26 @@ void ClassDecl::PrintChildren(int indentLevel) {
 }
 
 void ClassDecl::BuildST() {
-    if (symtab->LocalLookup(this->GetId())) {
+    if (ctx->symtab->LocalLookup(this->GetId())) {
         // if two local symbols have the same name, then report an error.
-        Decl *d = symtab->Lookup(this->GetId());
+        Decl *d = ctx->symtab->Lookup(this->GetId());
         ReportError::DeclConflict(this, d);
     } else {
-        idx = symtab->InsertSymbol(this);
+        idx = ctx->symtab->InsertSymbol(this);
         id->SetDecl(this);
     }
     // record the owner of the current class scope.
-    symtab->BuildScope(this->GetId()->GetIdName());
+    ctx->symtab->BuildScope(this->GetId()->GetIdName());
     if (extends) {
         // record the parent of the current class.
-        symtab->SetScopeParent(extends->GetId()->GetIdName());
+        ctx->symtab->SetScopeParent(extends->GetId()->GetIdName());
     }
     // record the implements of the current class.
     for (int i = 0; i < implements->NumElements(); i++) {
-        symtab->SetInterface(implements->Nth(i)->GetId()->GetIdName());
+        ctx->symtab->SetInterface(implements->Nth(i)->GetId()->GetIdName());
     }
     members->CheckAll(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void ClassDecl::CheckDecl() {
@@ -145,16 +150,15 @@ void ClassDecl::CheckDecl() {
     for (int i = 0; i < implements->NumElements(); i++) {
         implements->Nth(i)->Check(E_CheckDecl, LookingForInterface);
     }
-    symtab->EnterScope();
+    ctx->symtab->EnterScope();
     members->CheckAll(E_CheckDecl);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 
-    expr_type = new NamedType(id);
-    expr_type->SetSelfType();
+    expr_type = ctx->typetab->GetNamedType(this);
 }
 
 void ClassDecl::CheckInherit() {
-    symtab->EnterScope();
+    ctx->symtab->EnterScope();
 
     for (int i = 0; i < members->NumElements(); i++) {
         Decl *d = members->Nth(i);
@@ -162,13 +166,13 @@ void ClassDecl::CheckInherit() {
 
         if (d->IsVarDecl()) {
             // check class inheritance of variables.
-            Decl *t = symtab->LookupParent(d->GetId());
+            Decl *t = ctx->symtab->LookupParent(d->GetId());
             if (t != NULL) {
                 // subclass cannot override inherited variables.
                 ReportError::DeclConflict(d, t);
             }
             // check interface inheritance of variables.
-            t = symtab->LookupInterface(d->GetId());
+            t = ctx->symtab->LookupInterface(d->GetId());
             if (t != NULL) {
                 // variable names conflict with interface method names.
                 ReportError::DeclConflict(d, t);
@@ -176,7 +180,7 @@ void ClassDecl::CheckInherit() {
 
         } else if (d->IsFnDecl()) {
             // check class inheritance of functions.
-            Decl *t = symtab->LookupParent(d->GetId());
+            Decl *t = ctx->symtab->LookupParent(d->GetId());
             if (t != NULL) {
                 if (!t->IsFnDecl()) {
                     ReportError::DeclConflict(d, t);
@@ -192,7 +196,7 @@ void ClassDecl::CheckInherit() {
                 }
             }
             // check interface inheritance of functions.
-            t = symtab->LookupInterface(d->GetId());
+            t = ctx->symtab->LookupInterface(d->GetId());
             if (t != NULL) {
                 // compare the function signature.
                 FnDecl *fn1 = dynamic_cast<FnDecl*>(d);
@@ -208,7 +212,7 @@ void ClassDecl::CheckInherit() {
         }
     }
 
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void ClassDecl::Check(checkT c) {
@@ -223,108 +227,145 @@ void ClassDecl::Check(checkT c) {
             id->Check(c);
             if (extends) extends->Check(c);
             implements->CheckAll(c);
-            symtab->EnterScope();
+            ctx->symtab->EnterScope();
             members->CheckAll(c);
-            symtab->ExitScope();
+            ctx->symtab->ExitScope();
     }
 }
 
 bool ClassDecl::IsChildOf(Decl *other) {
-    if (other->IsClassDecl()) {
-        if (id->IsEquivalentTo(other->GetId())) {
-            // self.
-            return true;
-        } else if (!extends) {
-            return false;
-        } else {
-            // look up all the parent classes.
-            Decl *d = extends->GetId()->GetDecl();
-            return dynamic_cast<ClassDecl*>(d)->IsChildOf(other);
-        }
+    if (other == this) {
+        // self.
+        return true;
+    } else if (pre_num == -1) {
+        // not numbered, the inheritance has a loop.
+        return false;
+    } else if (other->IsClassDecl()) {
+        // the interval of a subclass is nested in its parents' intervals.
+        ClassDecl *c = dynamic_cast<ClassDecl*>(other);
+        return c->pre_num <= pre_num && post_num <= c->post_num;
     } else if (other->IsInterfaceDecl()) {
-        for (int i = 0; i < implements->NumElements(); i++) {
-            Identifier *iid = implements->Nth(i)->GetId();
-            if (iid->IsEquivalentTo(other->GetId())) {
-                return true;
-            }
-        }
-        if (!extends) {
-            return false;
-        } else {
-            // look up all the parent classes' interfaces.
-            Decl *d = extends->GetId()->GetDecl();
-            return dynamic_cast<ClassDecl*>(d)->IsChildOf(other);
-        }
+        return this->Implements(dynamic_cast<InterfaceDecl*>(other));
     } else {
         return false;
     }
 }
 
-void ClassDecl::AddMembersToList(List<VarDecl*> *vars, List<FnDecl*> *fns) {
-    for (int i = members->NumElements() - 1; i >= 0; i--) {
-        Decl *d = members->Nth(i);
-        if (d->IsVarDecl()) {
-            vars->InsertAt(dynamic_cast<VarDecl*>(d), 0);
-        } else if (d->IsFnDecl()) {
-            fns->InsertAt(dynamic_cast<FnDecl*>(d), 0);
+bool ClassDecl::Implements(InterfaceDecl *itfc) {
+    int n = itfc->GetInterfaceNum();
+    return itfc_set && n >= 0 && n < itfc_set->size() && itfc_set->at(n);
+}
+
+ClassDecl * ClassDecl::GetParentClass() {
+    if (!extends) return NULL;
+    Decl *d = extends->GetId()->GetDecl();
+    return (d && d->IsClassDecl()) ? dynamic_cast<ClassDecl*>(d) : NULL;
+}
+
+/* Number the interfaces in declaration order, then number the classes by a
+ * preorder/postorder walk of the inheritance forest. Each class also records
+ * the set of interfaces implemented by itself or its parents.
+ */
+void ClassDecl::NumberHierarchy(List<Decl*> *decls) {
+    int n_itfc = 0;
+    for (int i = 0; i < decls->NumElements(); i++) {
+        Decl *d = decls->Nth(i);
+        if (d->IsInterfaceDecl()) {
+            dynamic_cast<InterfaceDecl*>(d)->SetInterfaceNum(n_itfc++);
+        }
+    }
+    for (int i = 0; i < decls->NumElements(); i++) {
+        Decl *d = decls->Nth(i);
+        if (d->IsClassDecl()) {
+            ClassDecl *c = dynamic_cast<ClassDecl*>(d);
+            ClassDecl *p = c->GetParentClass();
+            if (p) p->children->Append(c);
+        }
+    }
+    int counter = 0;
+    for (int i = 0; i < decls->NumElements(); i++) {
+        Decl *d = decls->Nth(i);
+        if (d->IsClassDecl()) {
+            ClassDecl *c = dynamic_cast<ClassDecl*>(d);
+            if (!c->GetParentClass()) c->NumberSubtree(&counter, n_itfc);
         }
     }
 }
 
-void ClassDecl::AssignOffset() {
-    // deal with class inheritance.
-    // add all parents' methods.
-    var_members = new List<VarDecl*>;
-    methods = new List<FnDecl*>;
-    ClassDecl *c = this;
-    while (c) {
-        c->AddMembersToList(var_members, methods);
-        NamedType *t = c->GetExtends();
-        if (!t) break;
-        c = dynamic_cast<ClassDecl*>(t->GetId()->GetDecl());
-    }
-
-    // delete override methods.
-    for (int i = 0; i < methods->NumElements(); i++) {
-        FnDecl *f1 = methods->Nth(i);
-        for (int j = i + 1; j < methods->NumElements(); j++) {
-            FnDecl *f2 = methods->Nth(j);
-            if (!strcmp(f1->GetId()->GetIdName(), f2->GetId()->GetIdName())) {
-                // replace the parent's method with child's method, then the
-                // order of the methods can be compatible with both of them.
-                methods->RemoveAt(i);
-                methods->InsertAt(f2, i);
-                methods->RemoveAt(j);
-                j--;
-            }
+void ClassDecl::NumberSubtree(int *counter, int numInterfaces) {
+    pre_num = (*counter)++;
+
+    ClassDecl *p = this->GetParentClass();
+    itfc_set = p ? new std::vector<bool>(*p->itfc_set)
+                 : new std::vector<bool>(numInterfaces, false);
+    for (int i = 0; i < implements->NumElements(); i++) {
+        Decl *d = implements->Nth(i)->GetId()->GetDecl();
+        if (d && d->IsInterfaceDecl()) {
+            itfc_set->at(dynamic_cast<InterfaceDecl*>(d)->GetInterfaceNum())
+                = true;
         }
     }
 
-    PrintDebug("tac+", "Class Methods of %s:", id->GetIdName());
-    for (int i = 0; i < methods->NumElements(); i++) {
-        PrintDebug("tac+", "%s", methods->Nth(i)->GetId()->GetIdName());
-    }
-    PrintDebug("tac+", "Class Vars of %s:", id->GetIdName());
-    for (int i = 0; i < var_members->NumElements(); i++) {
-        PrintDebug("tac+", "%s", var_members->Nth(i)->GetId()->GetIdName());
+    for (int i = 0; i < children->NumElements(); i++) {
+        children->Nth(i)->NumberSubtree(counter, numInterfaces);
     }
 
-    // assign offset for fn members.
-    instance_size = var_members->NumElements() * 4 + 4;
-    vtable_size = methods->NumElements() * 4;
+    post_num = (*counter)++;
+    Trace(T_SymbolTable, "Number class %s [%d, %d].\n", id->GetIdName(),
+            pre_num, post_num);
+}
 
-    int var_offset = instance_size;
-    for (int i = members->NumElements() - 1; i >= 0; i--) {
+/* Compute the layout of every class, parents before children, then report
+ * the classes which do not implement all the methods of their interfaces.
+ */
+void ClassDecl::LayoutClasses(List<Decl*> *decls) {
+    for (int i = 0; i < decls->NumElements(); i++) {
+        Decl *d = decls->Nth(i);
+        if (d->IsClassDecl()) {
+            ClassDecl *c = dynamic_cast<ClassDecl*>(d);
+            c->BuildLayout();
+            c->CheckImplements();
+        }
+    }
+}
+
+void ClassDecl::BuildLayout() {
+    if (layout) return;
+    // a class in an inheritance loop is not numbered, lay it out alone.
+    ClassDecl *p = pre_num == -1 ? NULL : this->GetParentClass();
+    if (p) p->BuildLayout();
+    layout = new ClassLayout(this, p ? p->layout : NULL);
+    for (int i = 0; i < members->NumElements(); i++) {
         Decl *d = members->Nth(i);
-        if (d->IsVarDecl()) {
-            var_offset -= 4;
-            d->AssignMemberOffset(true, var_offset);
+        if (d->GetId()->GetDecl() != d) {
+            // a conflicting decl, which is not in the symbol table.
+            continue;
+        } else if (d->IsVarDecl()) {
+            layout->AddField(dynamic_cast<VarDecl*>(d));
         } else if (d->IsFnDecl()) {
-            // find the right offset.
-            for (int i = 0; i < methods->NumElements(); i++) {
-                FnDecl *f1 = methods->Nth(i);
-                if (!strcmp(f1->GetId()->GetIdName(), d->GetId()->GetIdName()))
-                    d->AssignMemberOffset(true, i * 4);
+            layout->AddMethod(dynamic_cast<FnDecl*>(d));
+        }
+    }
+    for (int i = 0; i < implements->NumElements(); i++) {
+        Decl *d = implements->Nth(i)->GetId()->GetDecl();
+        if (d && d->IsInterfaceDecl()) {
+            layout->AddInterface(dynamic_cast<InterfaceDecl*>(d));
+        }
+    }
+    layout->Print();
+}
+
+void ClassDecl::CheckImplements() {
+    for (int i = 0; i < implements->NumElements(); i++) {
+        NamedType *t = implements->Nth(i);
+        Decl *d = t->GetId()->GetDecl();
+        if (!d || !d->IsInterfaceDecl()) continue;
+        // every interface method needs a slot in the vtable.
+        List<Decl*> *m = dynamic_cast<InterfaceDecl*>(d)->GetMembers();
+        for (int j = 0; j < m->NumElements(); j++) {
+            if (!layout->LookupMethod(m->Nth(j)->GetId()->GetIdName())) {
+                ReportError::InterfaceNotImplemented(this, t);
+                break;
             }
         }
     }
@@ -337,23 +378,47 @@ void ClassDecl::AddPrefixToMethods() {
     }
 }
 
+/*
+ * The members are units of their own, so the methods can be emitted in
+ * parallel. The class itself follows its members, to emit the tables. An
+ * imported class is emitted with its library.
+ */
+void ClassDecl::AddEmitUnits(List<Decl*> *units) {
+    if (imported) return;
+    for (int i = 0; i < members->NumElements(); i++) {
+        members->Nth(i)->AddEmitUnits(units);
+    }
+    units->Append(this);
+}
+
 void ClassDecl::Emit() {
-    PrintDebug("tac+", "Begin Emitting TAC in ClassDecl.");
+    Trace(T_Emit, "Begin Emitting TAC in ClassDecl.");
 
-    members->EmitAll();
+    // Emit the interface tables, indexed by the interface number.
+    int n_itfc = itfc_set ? itfc_set->size() : 0;
+    List<const char*> *itable_labels = new List<const char*>;
+    for (int i = 0; i < n_itfc; i++) {
+        itable_labels->Append(NULL);
+    }
+    for (int i = 0; i < layout->NumInterfaces(); i++) {
+        InterfaceDecl *itfc = layout->GetInterface(i);
+        const char *name = itfc->GetId()->GetIdName();
+        char *label = new char[strlen(id->GetIdName()) + strlen(name) + 2];
+        sprintf(label, "%s.%s", id->GetIdName(), name);
+        ctx->cg->GenITable(label, layout->GetITableLabels(itfc));
+        itable_labels->RemoveAt(itfc->GetInterfaceNum());
+        itable_labels->InsertAt(label, itfc->GetInterfaceNum());
+    }
 
     // Emit VTable.
-    List<const char*> *method_labels = new List<const char*>;
-    for (int i = 0; i < methods->NumElements(); i++) {
-        FnDecl* fn = methods->Nth(i);
-        PrintDebug("tac+", "Insert %s into VTable.", fn->GetId()->GetIdName());
-        method_labels->Append(fn->GetId()->GetIdName());
-    }
+    ctx->cg->GenVTable(id->GetIdName(), layout->GetMethodLabels(),
+            itable_labels);
 }
 
 InterfaceDecl::InterfaceDecl(Identifier *n, List<Decl*> *m) : Decl(n) {
     Assert(n != NULL && m != NULL);
     (members=m)->SetParentAll(this);
+    itfc_num = -1;
 }
 
 void InterfaceDecl::PrintChildren(int indentLevel) {
@@ -365,16 +430,16 @@ void InterfaceDecl::PrintChildren(int indentLevel) {
 }
 
 void InterfaceDecl::BuildST() {
-    if (symtab->LocalLookup(this->GetId())) {
-        Decl *d = symtab->Lookup(this->GetId());
+    if (ctx->symtab->LocalLookup(this->GetId())) {
+        Decl *d = ctx->symtab->Lookup(this->GetId());
         ReportError::DeclConflict(this, d);
     } else {
-        idx = symtab->InsertSymbol(this);
+        idx = ctx->symtab->InsertSymbol(this);
         id->SetDecl(this);
     }
-    symtab->BuildScope(this->GetId()->GetIdName());
+    ctx->symtab->BuildScope(this->GetId()->GetIdName());
     members->CheckAll(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void InterfaceDecl::Check(checkT c) {
@@ -382,21 +447,25 @@ void InterfaceDecl::Check(checkT c) {
         case E_BuildST:
             this->BuildST(); break;
         case E_CheckDecl:
-            expr_type = new NamedType(id);
-            expr_type->SetSelfType();
+            expr_type = ctx->typetab->GetNamedType(this);
             // fall through.
         default:
             id->Check(c);
-            symtab->EnterScope();
+            ctx->symtab->EnterScope();
             members->CheckAll(c);
-            symtab->ExitScope();
+            ctx->symtab->ExitScope();
+    }
+}
+
+void InterfaceDecl::AssignOffset() {
+    // the slots of the methods in the interface tables.
+    for (int i = 0; i < members->NumElements(); i++) {
+        members->Nth(i)->AssignMemberOffset(false, i * CodeGenerator::VarSize);
     }
 }
 
 void InterfaceDecl::Emit() {
-    ReportError::Formatted(this->GetLocation(),
-            "Interface is not supported by compiler back end yet.");
-    Assert(0);
+    // nothing to emit, the interface tables are emitted by the classes.
 }
 
 FnDecl::FnDecl(Identifier *n, Type *r, List<VarDecl*> *d) : Decl(n) {
@@ -404,11 +473,13 @@ FnDecl::FnDecl(Identifier *n, Type *r, List<VarDecl*> *d) : Decl(n) {
     (returnType=r)->SetParent(this);
     (formals=d)->SetParentAll(this);
     body = NULL;
+    body_loc = NULL;
     vtable_ofst = -1;
 }
 
-void FnDecl::SetFunctionBody(Stmt *b) {
+void FnDecl::SetFunctionBody(Stmt *b, yyltype loc) {
     (body=b)->SetParent(this);
+    body_loc = new yyltype(loc);
 }
 
 void FnDecl::PrintChildren(int indentLevel) {
@@ -424,26 +495,26 @@ void FnDecl::PrintChildren(int indentLevel) {
 }
 
 void FnDecl::BuildST() {
-    if (symtab->LocalLookup(this->GetId())) {
-        Decl *d = symtab->Lookup(this->GetId());
+    if (ctx->symtab->LocalLookup(this->GetId())) {
+        Decl *d = ctx->symtab->Lookup(this->GetId());
         ReportError::DeclConflict(this, d);
     } else {
-        idx = symtab->InsertSymbol(this);
+        idx = ctx->symtab->InsertSymbol(this);
         id->SetDecl(this);
     }
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     formals->CheckAll(E_BuildST);
-    if (body) body->Check(E_BuildST); // function body must be a StmtBlock.
-    symtab->ExitScope();
+    ctx->checkTasks->Defer(this); // the body is checked in a fused walk.
+    ctx->symtab->ExitScope();
 }
 
 void FnDecl::CheckDecl() {
     returnType->Check(E_CheckDecl);
     id->Check(E_CheckDecl);
-    symtab->EnterScope();
+    ctx->symtab->EnterScope();
     formals->CheckAll(E_CheckDecl);
-    if (body) body->Check(E_CheckDecl);
-    symtab->ExitScope();
+    ctx->checkTasks->Slot(E_CheckDecl);
+    ctx->symtab->ExitScope();
 
     // check the signature of the main function.
     if (!strcmp(id->GetIdName(), "main")) {
@@ -468,10 +539,88 @@ void FnDecl::Check(checkT c) {
         default:
             returnType->Check(c);
             id->Check(c);
-            symtab->EnterScope();
+            ctx->symtab->EnterScope();
             formals->CheckAll(c);
-            if (body) body->Check(c);
-            symtab->ExitScope();
+            if (c == E_CheckType) ctx->checkTasks->Slot(c);
+            ctx->symtab->ExitScope();
+    }
+}
+
+/*
+ * The fused walk of the body, the symbol table is at the scope of the
+ * formals. See CheckTasks.
+ */
+void FnDecl::CheckBody() {
+    if (body) body->CheckBody();
+}
+
+CheckTasks::CheckTasks() {
+    tasks = new List<Task*>;
+    segments = new List<std::ostringstream*>;
+    for (int c = E_BuildST; c <= E_CheckType; c++) slots[c] = 0;
+    err = ctx->err;
+    NextSegment();
+}
+
+/*
+ * The errors of the walk after a slot go to a new segment.
+ */
+void CheckTasks::NextSegment() {
+    std::ostringstream *s = new std::ostringstream;
+    segments->Append(s);
+    ctx->err = s;
+}
+
+void CheckTasks::Defer(FnDecl *fn) {
+    Task *t = new Task;
+    t->fn = fn;
+    t->symtab = ctx->symtab->Fork();
+    t->numErrors = 0;
+    tasks->Append(t);
+    Slot(E_BuildST);
+}
+
+void CheckTasks::Slot(checkT c) {
+    // each pass visits the functions in the same order.
+    Assert(slots[c] < tasks->NumElements());
+    Task *t = tasks->Nth(slots[c]++);
+    segments->Append(&t->err[c]);
+    NextSegment();
+}
+
+void CheckTasks::Run() {
+    // the bodies found in the cache of the compile server are not checked.
+    UnitCache *cache = ctx->unitCache;
+    if (cache) {
+        List<FnDecl*> *fns = new List<FnDecl*>;
+        for (int i = 0; i < tasks->NumElements(); i++)
+            fns->Append(tasks->Nth(i)->fn);
+        cache->Begin(fns);
+    }
+
+    CompilationContext *parent = ctx;
+    ParallelFor(tasks->NumElements(), ctx->numThreads, [&](int i) {
+        Task *t = tasks->Nth(i);
+        t->numErrors = 0;
+        if (cache && cache->Lookup(t->fn)) return;
+        CompilationContext local(*parent);
+        local.symtab = t->symtab;
+        local.checkTasks = NULL;
+        for (int c = E_BuildST; c <= E_CheckType; c++)
+            local.passErr[c] = &t->err[c];
+        local.numErrors = 0;
+        ctx = &local;
+        t->fn->CheckBody();
+        ctx = parent;
+        t->numErrors = local.numErrors;
+    });
+
+    ctx->err = err;
+    for (int i = 0; i < segments->NumElements(); i++) {
+        *err << segments->Nth(i)->str();
+    }
+    for (int i = 0; i < tasks->NumElements(); i++) {
+        ctx->numErrors += tasks->Nth(i)->numErrors;
     }
 }
 
@@ -519,22 +668,21 @@ void FnDecl::AssignMemberOffset(bool inClass, int offset) {
 }
 
 void FnDecl::Emit() {
-    PrintDebug("tac+", "Begin Emitting TAC in FnDecl.");
+    Trace(T_Emit, "Begin Emitting TAC in FnDecl.");
     if (returnType == Type::doubleType) {
         ReportError::Formatted(this->GetLocation(),
                 "Double type is not supported by compiler back end yet.");
-        Assert(0);
     }
 
     Decl *d = dynamic_cast<Decl*>(this->GetParent());
-    CG->GenLabel(id->GetIdName());
+    ctx->cg->GenLabel(id->GetIdName());
 
     // BeginFunc will reset the FP offset counter.
-    BeginFunc *f = CG->GenBeginFunc();
+    BeginFunc *f = ctx->cg->GenBeginFunc();
 
     // Add 4 to the offset of the 1st param for class member.
     if (d && d->IsClassDecl()) {
-        CG->GetNextParamLoc();
+        ctx->cg->GetNextParamLoc();
     }
 
     // Generate all the Locations for formals.
@@ -543,18 +691,19 @@ void FnDecl::Emit() {
         if (v->GetType() == Type::doubleType) {
             ReportError::Formatted(this->GetLocation(),
                     "Double type is not supported by compiler back end yet.");
-            Assert(0);
         }
-        Location *l = new Location(fpRelative, CG->GetNextParamLoc(),
+        Location *l = new Location(fpRelative, ctx->cg->GetNextParamLoc(),
                 v->GetId()->GetIdName());
         v->SetEmitLoc(l);
     }
 
     if (body) body->Emit();
+    if (ctx->instrument) ctx->cg->Instrument(f, id->GetIdName());
+    if (ctx->profile) ctx->cg->LayoutBlocks(f, id->GetIdName());
 
     // Backpatch the frame size.
-    f->SetFrameSize(CG->GetFrameSize());
+    f->SetFrameSize(ctx->cg->GetFrameSize());
 
-    CG->GenEndFunc();
+    ctx->cg->GenEndFunc();
 }
 
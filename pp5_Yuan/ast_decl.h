@@ -18,9 +18,11 @@
 #ifndef _H_ast_decl
 #define _H_ast_decl
 
+#include <sstream>
 #include "ast.h"
 #include "list.h"
 #include "ast_type.h"
+#include "layout.h"
 
 class Type;
 class NamedType;
@@ -32,6 +34,7 @@ class Decl : public Node
   protected:
     Identifier *id;
     int idx;
+    bool imported;                  // from a summary, see summary.h.
 
   public:
     // constructor.
@@ -46,10 +49,15 @@ class Decl : public Node
     virtual bool IsClassDecl() { return false; }
     virtual bool IsInterfaceDecl() { return false; }
     virtual bool IsFnDecl() { return false; }
+    void SetImported() { imported = true; }
+    bool IsImported() { return imported; }
     // code generation stuff.
     virtual void AssignOffset() {}
     virtual void AssignMemberOffset(bool inClass, int offset) {}
     virtual void AddPrefixToMethods() {}
+    // the parts of the program emitted on their own, see Program::Emit.
+    virtual void AddEmitUnits(List<Decl*> *units)
+        { if (!imported) units->Append(this); }
 };
 
 class VarDecl : public Decl
@@ -73,6 +81,7 @@ class VarDecl : public Decl
     void AssignMemberOffset(bool inClass, int offset);
     void Emit();
     void SetEmitLoc(Location *l) { emit_loc = l; }
+    int GetMemberOffset() { return class_member_ofst; }
 
   protected:
     void BuildST();
@@ -85,6 +94,7 @@ class VarDecl : public Decl
 };
 
 class FnDecl;
+class InterfaceDecl;
 
 class ClassDecl : public Decl
 {
@@ -92,10 +102,12 @@ class ClassDecl : public Decl
     List<Decl*> *members;
     NamedType *extends;
     List<NamedType*> *implements;
-    int instance_size;
-    int vtable_size;
-    List<VarDecl*> *var_members;
-    List<FnDecl*> *methods;
+    ClassLayout *layout; // vtable and instance vars, see layout.h.
+    // class hierarchy numbering: a class is a subclass of another iff its
+    // preorder/postorder interval is nested in the other's interval.
+    int pre_num, post_num;
+    std::vector<bool> *itfc_set; // interfaces implemented, by number.
+    List<ClassDecl*> *children;
 
   public:
     // constructor.
@@ -109,24 +121,38 @@ class ClassDecl : public Decl
     bool IsClassDecl() { return true; }
     bool IsChildOf(Decl *other);
     NamedType * GetExtends() { return extends; }
+    List<NamedType*> * GetImplements() { return implements; }
+    List<Decl*> * GetMembers() { return members; }
+    ClassDecl * GetParentClass();
+    // class hierarchy numbering, also used by the code generator.
+    static void NumberHierarchy(List<Decl*> *decls);
+    int GetPreOrder() { return pre_num; }
+    int GetPostOrder() { return post_num; }
+    bool Implements(InterfaceDecl *itfc);
+    // class layout, computed once after the inheritance check.
+    static void LayoutClasses(List<Decl*> *decls);
+    ClassLayout * GetLayout() { return layout; }
     // code generation stuff.
-    void AssignOffset();
     void Emit();
-    int GetInstanceSize() { return instance_size; }
-    int GetVTableSize() { return vtable_size; }
-    void AddMembersToList(List<VarDecl*> *vars, List<FnDecl*> *fns);
+    int GetInstanceSize() { return layout->GetInstanceSize(); }
+    int GetVTableSize() { return layout->GetVTableSize(); }
     void AddPrefixToMethods();
+    void AddEmitUnits(List<Decl*> *units);
 
   protected:
     void BuildST();
     void CheckDecl();
     void CheckInherit();
+    void BuildLayout();
+    void CheckImplements();
+    void NumberSubtree(int *counter, int numInterfaces);
 };
 
 class InterfaceDecl : public Decl
 {
   protected:
     List<Decl*> *members;
+    int itfc_num;
 
   public:
     // constructor.
@@ -138,7 +164,10 @@ class InterfaceDecl : public Decl
     void Check(checkT c);
     bool IsInterfaceDecl() { return true; }
     List<Decl*> * GetMembers() { return members; }
+    void SetInterfaceNum(int n) { itfc_num = n; }
+    int GetInterfaceNum() { return itfc_num; }
     // code generation stuff.
+    void AssignOffset();
     void Emit();
 
   protected:
@@ -152,12 +181,13 @@ class FnDecl : public Decl
     List<VarDecl*> *formals;
     Type *returnType;
     Stmt *body;
+    yyltype *body_loc;              // from '{' to '}'.
     int vtable_ofst;
 
   public:
     // constructor.
     FnDecl(Identifier *name, Type *returnType, List<VarDecl*> *formals);
-    void SetFunctionBody(Stmt *b);
+    void SetFunctionBody(Stmt *b, yyltype loc);
     // print stuff.
     const char *GetPrintNameForNode() { return "FnDecl"; }
     void PrintChildren(int indentLevel);
@@ -166,6 +196,7 @@ class FnDecl : public Decl
     bool IsFnDecl() { return true; }
     bool IsEquivalentTo(Decl *fn);
     List<VarDecl*> * GetFormals() { return formals; }
+    yyltype * GetBodyLocation() { return body_loc; }
     // code generation stuff.
     void AddPrefixToMethods();
     void AssignMemberOffset(bool inClass, int offset);
@@ -176,10 +207,56 @@ class FnDecl : public Decl
         Decl *d = dynamic_cast<Decl*>(this->GetParent());
         return d ? d->IsClassDecl() : false;
     }
+    InterfaceDecl * GetInterface() {
+        Decl *d = dynamic_cast<Decl*>(this->GetParent());
+        return (d && d->IsInterfaceDecl()) ?
+            dynamic_cast<InterfaceDecl*>(d) : NULL;
+    }
 
   protected:
     void BuildST();
     void CheckDecl();
+    void CheckBody();
+
+    friend class CheckTasks;
+};
+
+/* The function bodies are checked apart from the passes over the
+ * declarations. Pass 1 defers the body of each function as a task, with a
+ * fork of the symbol table at the scope of the formals, and each pass
+ * leaves a slot for the errors of the body where it would have walked the
+ * body. After pass 4, each body is checked in one fused walk, which builds
+ * its scopes and resolves its names and checks its types together, with
+ * the errors of each pass kept apart. The bodies only depend on the
+ * declarations, so the tasks run in parallel. At last, the errors of the
+ * passes and of the slots are printed in order, which is the order of the
+ * four passes over the whole program.
+ */
+class CheckTasks
+{
+  protected:
+    struct Task {
+        FnDecl *fn;
+        SymbolTable *symtab;
+        std::ostringstream err[E_CheckType + 1];    // by pass.
+        int numErrors;
+    };
+    List<Task*> *tasks;
+    List<std::ostringstream*> *segments;    // the errors, in order.
+    int slots[E_CheckType + 1];     // the slots taken in each pass.
+    std::ostream *err;              // where the errors go in the end.
+
+    void NextSegment();
+
+  public:
+    // starts buffering the errors of the passes.
+    CheckTasks();
+    // called by pass 1 at the body of a function.
+    void Defer(FnDecl *fn);
+    // called by the other passes at the body of the next function.
+    void Slot(checkT c);
+    // checks the bodies and prints all the errors in order.
+    void Run();
 };
 
 #endif
@@ -11,6 +11,7 @@
 #include "ast_expr.h"
 #include "ast_type.h"
 #include "errors.h"
+#include "trace.h"
 
 void EmptyExpr::PrintChildren(int indentLevel) {
     if (expr_type) std::cout << " <" << expr_type << ">";
@@ -40,7 +41,7 @@ void IntConstant::Check(checkT c) {
 }
 
 void IntConstant::Emit() {
-    emit_loc = CG->GenLoadConstant(value);
+    emit_loc = ctx->cg->GenLoadConstant(value);
 }
 
 DoubleConstant::DoubleConstant(yyltype loc, double val) : Expr(loc) {
@@ -60,9 +61,10 @@ void DoubleConstant::Check(checkT c) {
 }
 
 void DoubleConstant::Emit() {
+    // the program is not emitted, the location only keeps the Tac whole.
     ReportError::Formatted(this->GetLocation(),
             "Double is not supported by compiler back end yet.");
-    Assert(0);
+    emit_loc = ctx->cg->GenLoadConstant(0);
 }
 
 BoolConstant::BoolConstant(yyltype loc, bool val) : Expr(loc) {
@@ -82,16 +84,18 @@ void BoolConstant::Check(checkT c) {
 }
 
 void BoolConstant::Emit() {
-    emit_loc = CG->GenLoadConstant(value ? 1 : 0);
+    emit_loc = ctx->cg->GenLoadConstant(value ? 1 : 0);
 }
 
-StringConstant::StringConstant(yyltype loc, const char *val) : Expr(loc) {
-    Assert(val != NULL);
-    value = strdup(val);
+StringConstant::StringConstant(yyltype loc, const char *val, int len)
+        : Expr(loc) {
+    Assert(val != NULL && len >= 0);
+    value = val;
+    length = len;
 }
 
 void StringConstant::PrintChildren(int indentLevel) {
-    printf("%s",value);
+    printf("%.*s", length, value);
     if (expr_type) std::cout << " <" << expr_type << ">";
     if (emit_loc) emit_loc->Print();
 }
@@ -103,7 +107,7 @@ void StringConstant::Check(checkT c) {
 }
 
 void StringConstant::Emit() {
-    emit_loc = CG->GenLoadConstant(value);
+    emit_loc = ctx->cg->GenLoadConstant(value, length);
 }
 
 void NullConstant::PrintChildren(int indentLevel) {
@@ -118,7 +122,7 @@ void NullConstant::Check(checkT c) {
 }
 
 void NullConstant::Emit() {
-    emit_loc = CG->GenLoadConstant(0);
+    emit_loc = ctx->cg->GenLoadConstant(0);
 }
 
 Operator::Operator(yyltype loc, const char *tok) : Node(loc) {
@@ -205,8 +209,9 @@ void ArithmeticExpr::Emit() {
     if (left) left->Emit();
     right->Emit();
 
-    Location *l = left ? left->GetEmitLocDeref() : CG->GenLoadConstant(0);
-    emit_loc = CG->GenBinaryOp(op->GetOpStr(), l, right->GetEmitLocDeref());
+    Location *l = left ? left->GetEmitLocDeref() : ctx->cg->GenLoadConstant(0);
+    emit_loc = ctx->cg->GenBinaryOp(op->GetOpStr(), l,
+            right->GetEmitLocDeref());
 }
 
 void RelationalExpr::CheckType() {
@@ -245,7 +250,7 @@ void RelationalExpr::Emit() {
     left->Emit();
     right->Emit();
 
-    emit_loc = CG->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
+    emit_loc = ctx->cg->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
             right->GetEmitLocDeref());
 }
 
@@ -288,20 +293,20 @@ void EqualityExpr::Emit() {
     Type *tr = right->GetType();
 
     if (tl == tr && (tl == Type::intType || tl == Type::boolType)) {
-        emit_loc = CG->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
+        emit_loc = ctx->cg->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
                 right->GetEmitLocDeref());
     } else if (tl == tr && tl == Type::stringType) {
-        emit_loc = CG->GenBuiltInCall(StringEqual, left->GetEmitLocDeref(),
+        emit_loc = ctx->cg->GenBuiltInCall(StringEqual, left->GetEmitLocDeref(),
                 right->GetEmitLocDeref());
         if (!strcmp(op->GetOpStr(), "!=")) {
             // for s1 != s2, generate s1 == s2, then generate logical not.
-            emit_loc = CG->GenBinaryOp("==", CG->GenLoadConstant(0),
+            emit_loc = ctx->cg->GenBinaryOp("==", ctx->cg->GenLoadConstant(0),
                 emit_loc);
         }
     } else {
         // array? class? interface?
         // just compare the reference.
-        emit_loc = CG->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
+        emit_loc = ctx->cg->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
                 right->GetEmitLocDeref());
     }
 }
@@ -351,11 +356,11 @@ void LogicalExpr::Emit() {
     right->Emit();
 
     if (left) {
-        emit_loc = CG->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
+        emit_loc = ctx->cg->GenBinaryOp(op->GetOpStr(), left->GetEmitLocDeref(),
                 right->GetEmitLocDeref());
     } else {
         // use 0 == bool_var to compute !bool_var.
-        emit_loc = CG->GenBinaryOp("==", CG->GenLoadConstant(0),
+        emit_loc = ctx->cg->GenBinaryOp("==", ctx->cg->GenLoadConstant(0),
                 right->GetEmitLocDeref());
     }
 }
@@ -396,11 +401,11 @@ void AssignExpr::Emit() {
     if (r && l) {
         // base can be this or class instances.
         if (l->GetBase() != NULL) {
-            CG->GenStore(l->GetBase(), r, l->GetOffset());
+            ctx->cg->GenStore(l->GetBase(), r, l->GetOffset());
         } else if (left->IsArrayAccessRef()) {
-            CG->GenStore(l, r);
+            ctx->cg->GenStore(l, r);
         } else {
-            CG->GenAssign(l, r);
+            ctx->cg->GenAssign(l, r);
         }
         emit_loc = left->GetEmitLocDeref();
     }
@@ -411,13 +416,11 @@ void This::PrintChildren(int indentLevel) {
 }
 
 void This::CheckType() {
-    Decl *d = symtab->LookupThis();
+    Decl *d = ctx->symtab->LookupThis();
     if (!d || !d->IsClassDecl()) {
         ReportError::ThisOutsideClassScope(this);
     } else {
-        // Note: here create a new NamedType for 'this'.
-        expr_type = new NamedType(d->GetId());
-        expr_type->SetSelfType();
+        expr_type = ctx->typetab->GetNamedType(d);
     }
 }
 
@@ -428,7 +431,7 @@ void This::Check(checkT c) {
 }
 
 void This::Emit() {
-    emit_loc = CG->ThisPtr;
+    emit_loc = CodeGenerator::ThisPtr;
 }
 
 ArrayAccess::ArrayAccess(yyltype loc, Expr *b, Expr *s) : LValue(loc) {
@@ -485,28 +488,28 @@ void ArrayAccess::Emit() {
     subscript->Emit();
     Location *t0 = subscript->GetEmitLocDeref();
 
-    Location *t1 = CG->GenLoadConstant(0);
-    Location *t2 = CG->GenBinaryOp("<", t0, t1);
+    Location *t1 = ctx->cg->GenLoadConstant(0);
+    Location *t2 = ctx->cg->GenBinaryOp("<", t0, t1);
     Location *t3 = base->GetEmitLocDeref();
-    Location *t4 = CG->GenLoad(t3, -4);
-    Location *t5 = CG->GenBinaryOp("<", t0, t4);
-    Location *t6 = CG->GenBinaryOp("==", t5, t1);
-    Location *t7 = CG->GenBinaryOp("||", t2, t6);
-    const char *l = CG->NewLabel();
-    CG->GenIfZ(t7, l);
-    Location *t8 = CG->GenLoadConstant(err_arr_out_of_bounds);
-    CG->GenBuiltInCall(PrintString, t8);
-    CG->GenBuiltInCall(Halt);
-    CG->GenLabel(l);
-
-    Location *t9 = CG->GenLoadConstant(expr_type->GetTypeSize());
-    Location *t10 = CG->GenBinaryOp("*", t9, t0);
-    Location *t11 = CG->GenBinaryOp("+", t3, t10);
+    Location *t4 = ctx->cg->GenLoad(t3, -4);
+    Location *t5 = ctx->cg->GenBinaryOp("<", t0, t4);
+    Location *t6 = ctx->cg->GenBinaryOp("==", t5, t1);
+    Location *t7 = ctx->cg->GenBinaryOp("||", t2, t6);
+    const char *l = ctx->cg->NewLabel();
+    ctx->cg->GenIfZ(t7, l);
+    Location *t8 = ctx->cg->GenLoadConstant(err_arr_out_of_bounds);
+    ctx->cg->GenBuiltInCall(PrintString, t8);
+    ctx->cg->GenBuiltInCall(Halt);
+    ctx->cg->GenLabel(l);
+
+    Location *t9 = ctx->cg->GenLoadConstant(expr_type->GetTypeSize());
+    Location *t10 = ctx->cg->GenBinaryOp("*", t9, t0);
+    Location *t11 = ctx->cg->GenBinaryOp("+", t3, t10);
     emit_loc = t11;
 }
 
 Location * ArrayAccess::GetEmitLocDeref() {
-    Location *t = CG->GenLoad(emit_loc, 0);
+    Location *t = ctx->cg->GenLoad(emit_loc, 0);
     return t;
 }
 
@@ -527,7 +530,7 @@ void FieldAccess::PrintChildren(int indentLevel) {
 
 void FieldAccess::CheckDecl() {
     if (!base) {
-        Decl *d = symtab->Lookup(field);
+        Decl *d = ctx->symtab->Lookup(field);
         if (d == NULL) {
             ReportError::IdentifierNotDeclared(field, LookingForVariable);
             return;
@@ -561,7 +564,7 @@ void FieldAccess::CheckType() {
             return;
         }
 
-        Decl *d = symtab->LookupField(
+        Decl *d = ctx->symtab->LookupField(
                 dynamic_cast<NamedType*>(base_t)->GetId(), field);
 
         if (d == NULL || !d->IsVarDecl()) {
@@ -573,7 +576,7 @@ void FieldAccess::CheckType() {
             // Note: If base is a subclass of current class, and the
             // field is belong to current class, then this field is
             // accessible.
-            Decl *cur_class = symtab->LookupThis();
+            Decl *cur_class = ctx->symtab->LookupThis();
             if (!cur_class || !cur_class->IsClassDecl()) {
                 // not in a class scope, all the variable members are
                 // not accessible.
@@ -583,7 +586,7 @@ void FieldAccess::CheckType() {
             // in a class scope, the variable members can be
             // accessed by 'this' or the compatible class instance.
             Type *cur_t = cur_class->GetType();
-            d = symtab->LookupField(
+            d = ctx->symtab->LookupField(
                     dynamic_cast<NamedType*>(cur_t)->GetId(), field);
 
             if (d == NULL || !d->IsVarDecl()) {
@@ -627,7 +630,7 @@ Location * FieldAccess::GetEmitLocDeref() {
     Location *t = emit_loc;
     if (t->GetBase() != NULL) {
         // this or some class instances.
-        t = CG->GenLoad(t->GetBase(), t->GetOffset());
+        t = ctx->cg->GenLoad(t->GetBase(), t->GetOffset());
     }
     return t;
 }
@@ -651,7 +654,7 @@ void Call::PrintChildren(int indentLevel) {
 
 void Call::CheckDecl() {
     if (!base) {
-        Decl *d = symtab->Lookup(field);
+        Decl *d = ctx->symtab->Lookup(field);
         if (d == NULL || !d->IsFnDecl()) {
             ReportError::IdentifierNotDeclared(field, LookingForFunction);
             return;
@@ -689,7 +692,7 @@ void Call::CheckType() {
             } else if (!t->IsNamedType()) {
                 ReportError::FieldNotFoundInBase(field, t);
             } else {
-                Decl *d = symtab->LookupField(
+                Decl *d = ctx->symtab->LookupField(
                         dynamic_cast<NamedType*>(t)->GetId(), field);
                 if (d == NULL || !d->IsFnDecl()) {
                     ReportError::FieldNotFoundInBase(field, t);
@@ -738,7 +741,7 @@ void Call::Check(checkT c) {
 }
 
 void Call::Emit() {
-    PrintDebug("tac+", "Emit Call %s.", field->GetIdName());
+    Trace(T_Emit, "Emit Call %s.", field->GetIdName());
     // TODO: in class scope, methon without base should be ACall.
 
     if (base) base->Emit();
@@ -749,7 +752,7 @@ void Call::Emit() {
     if (base && base->GetType()->IsArrayType() &&
             !strcmp(field->GetIdName(), "length")) {
         Location *t0 = base->GetEmitLocDeref();
-        Location *t1 = CG->GenLoad(t0, -4);
+        Location *t1 = ctx->cg->GenLoad(t0, -4);
         emit_loc = t1;
         return;
     }
@@ -763,36 +766,43 @@ void Call::Emit() {
     if (base) {
         this_loc = base->GetEmitLocDeref(); // VTable entry.
     } else if (fn->IsClassMember()) {
-        this_loc = CG->ThisPtr; // in a class scope.
+        this_loc = CodeGenerator::ThisPtr; // in a class scope.
     }
 
     Location *t;
-    if (is_ACall) {
-        t = CG->GenLoad(this_loc, 0);
-        t = CG->GenLoad(t, fn->GetVTableOffset());
+    if (is_ACall && fn->GetInterface()) {
+        // find the interface table below the VTable, then the method.
+        int n = fn->GetInterface()->GetInterfaceNum();
+        t = ctx->cg->GenLoad(this_loc, 0);
+        t = ctx->cg->GenLoad(t, -CodeGenerator::VarSize * (n + 1));
+        t = ctx->cg->GenLoad(t, fn->GetVTableOffset());
+    } else if (is_ACall) {
+        t = ctx->cg->GenLoad(this_loc, 0);
+        t = ctx->cg->GenLoad(t, fn->GetVTableOffset());
     }
 
     // PushParam
     for (int i = actuals->NumElements() - 1; i >= 0; i--) {
         Location *l = actuals->Nth(i)->GetEmitLocDeref();
-        CG->GenPushParam(l);
+        ctx->cg->GenPushParam(l);
     }
 
     // generate call.
     if (is_ACall) {
         // Push this.
-        CG->GenPushParam(this_loc);
+        ctx->cg->GenPushParam(this_loc);
         // ACall
-        emit_loc = CG->GenACall(t, fn->HasReturnValue());
+        emit_loc = ctx->cg->GenACall(t, fn->HasReturnValue(),
+                field->GetIdName());
         // PopParams
-        CG->GenPopParams(actuals->NumElements() * 4 + 4);
+        ctx->cg->GenPopParams(actuals->NumElements() * 4 + 4);
     } else {
         // LCall
         field->AddPrefix("_"); // main?
-        emit_loc = CG->GenLCall(field->GetIdName(),
+        emit_loc = ctx->cg->GenLCall(field->GetIdName(),
                 expr_type != Type::voidType);
         // PopParams
-        CG->GenPopParams(actuals->NumElements() * 4);
+        ctx->cg->GenPopParams(actuals->NumElements() * 4);
     }
 }
 
@@ -815,7 +825,7 @@ void NewExpr::CheckType() {
     cType->Check(E_CheckType);
     // cType is NamedType.
     if (cType->GetType()) { // correct cType
-        expr_type = cType;
+        expr_type = cType->GetType();
     }
 }
 
@@ -834,10 +844,10 @@ void NewExpr::Emit() {
     ClassDecl *d = dynamic_cast<ClassDecl*>(cType->GetId()->GetDecl());
     Assert(d);
     int size = d->GetInstanceSize();
-    Location *t = CG->GenLoadConstant(size);
-    emit_loc = CG->GenBuiltInCall(Alloc, t);
-    Location *l = CG->GenLoadLabel(d->GetId()->GetIdName());
-    CG->GenStore(emit_loc, l, 0);
+    Location *t = ctx->cg->GenLoadConstant(size);
+    emit_loc = ctx->cg->GenBuiltInCall(Alloc, t);
+    Location *l = ctx->cg->GenLoadLabel(d->GetId()->GetIdName());
+    ctx->cg->GenStore(emit_loc, l, 0);
 }
 
 NewArrayExpr::NewArrayExpr(yyltype loc, Expr *sz, Type *et) : Expr(loc) {
@@ -870,8 +880,7 @@ void NewArrayExpr::CheckType() {
         return;
     } else {
         // the error size will not affect the type of new array.
-        expr_type = new ArrayType(*location, elemType);
-        expr_type->Check(E_CheckDecl);
+        expr_type = ctx->typetab->GetArrayType(elemType->GetType());
     }
 }
 
@@ -887,23 +896,23 @@ void NewArrayExpr::Check(checkT c) {
 void NewArrayExpr::Emit() {
     size->Emit();
     Location *t0 = size->GetEmitLocDeref();
-    Location *t1 = CG->GenLoadConstant(0);
-    Location *t2 = CG->GenBinaryOp("<=", t0, t1);
-
-    const char *l = CG->NewLabel();
-    CG->GenIfZ(t2, l);
-    Location *t3 = CG->GenLoadConstant(err_arr_bad_size);
-    CG->GenBuiltInCall(PrintString, t3);
-    CG->GenBuiltInCall(Halt);
-
-    CG->GenLabel(l);
-    Location *t4 = CG->GenLoadConstant(1);
-    Location *t5 = CG->GenBinaryOp("+", t4, t0);
-    Location *t6 = CG->GenLoadConstant(elemType->GetTypeSize());
-    Location *t7 = CG->GenBinaryOp("*", t5, t6);
-    Location *t8 = CG->GenBuiltInCall(Alloc, t7);
-    CG->GenStore(t8, t0);
-    Location *t9 = CG->GenBinaryOp("+", t8, t6);
+    Location *t1 = ctx->cg->GenLoadConstant(0);
+    Location *t2 = ctx->cg->GenBinaryOp("<=", t0, t1);
+
+    const char *l = ctx->cg->NewLabel();
+    ctx->cg->GenIfZ(t2, l);
+    Location *t3 = ctx->cg->GenLoadConstant(err_arr_bad_size);
+    ctx->cg->GenBuiltInCall(PrintString, t3);
+    ctx->cg->GenBuiltInCall(Halt);
+
+    ctx->cg->GenLabel(l);
+    Location *t4 = ctx->cg->GenLoadConstant(1);
+    Location *t5 = ctx->cg->GenBinaryOp("+", t4, t0);
+    Location *t6 = ctx->cg->GenLoadConstant(elemType->GetTypeSize());
+    Location *t7 = ctx->cg->GenBinaryOp("*", t5, t6);
+    Location *t8 = ctx->cg->GenBuiltInCall(Alloc, t7);
+    ctx->cg->GenStore(t8, t0);
+    Location *t9 = ctx->cg->GenBinaryOp("+", t8, t6);
     emit_loc = t9;
 }
 
@@ -914,7 +923,7 @@ void ReadIntegerExpr::Check(checkT c) {
 }
 
 void ReadIntegerExpr::Emit() {
-    emit_loc = CG->GenBuiltInCall(ReadInteger);
+    emit_loc = ctx->cg->GenBuiltInCall(ReadInteger);
 }
 
 void ReadLineExpr::Check(checkT c) {
@@ -924,7 +933,7 @@ void ReadLineExpr::Check(checkT c) {
 }
 
 void ReadLineExpr::Emit() {
-    emit_loc = CG->GenBuiltInCall(ReadLine);
+    emit_loc = ctx->cg->GenBuiltInCall(ReadLine);
 }
 
 PostfixExpr::PostfixExpr(LValue *lv, Operator *o)
@@ -970,20 +979,20 @@ void PostfixExpr::Emit() {
     Location *l2 = lvalue->GetEmitLocDeref();
 
     // save the original lvalue.
-    Location *t0 = CG->GenTempVar();
-    CG->GenAssign(t0, l2);
+    Location *t0 = ctx->cg->GenTempVar();
+    ctx->cg->GenAssign(t0, l2);
 
     // postfix expr should emit ++ or -- at the end of itself.
-    l2 = CG->GenBinaryOp(strcmp(op->GetOpStr(), "++") ? "-" : "+",
-            l2, CG->GenLoadConstant(1));
+    l2 = ctx->cg->GenBinaryOp(strcmp(op->GetOpStr(), "++") ? "-" : "+",
+            l2, ctx->cg->GenLoadConstant(1));
 
     // change the value of lvalue.
     if (l1->GetBase() != NULL) {
-        CG->GenStore(l1->GetBase(), l2, l1->GetOffset());
+        ctx->cg->GenStore(l1->GetBase(), l2, l1->GetOffset());
     } else if (lvalue->IsArrayAccessRef()) {
-        CG->GenStore(l1, l2);
+        ctx->cg->GenStore(l1, l2);
     } else {
-        CG->GenAssign(l1, l2);
+        ctx->cg->GenAssign(l1, l2);
     }
 
     // the value of postfix expr is its original lvalue.
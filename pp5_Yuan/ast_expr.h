@@ -106,11 +106,12 @@ class BoolConstant : public Expr
 class StringConstant : public Expr
 {
   protected:
-    char *value;
+    const char *value; // a view of the input, not null terminated.
+    int length;
 
   public:
     // constructor.
-    StringConstant(yyltype loc, const char *val);
+    StringConstant(yyltype loc, const char *val, int len);
     // print stuff.
     const char *GetPrintNameForNode() { return "StringConstant"; }
     void PrintChildren(int indentLevel);
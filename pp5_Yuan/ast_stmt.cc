@@ -9,10 +9,49 @@
 #include "ast_expr.h"
 #include "ast_stmt.h"
 #include "ast_type.h"
+#include "summary.h"
+#include "stats.h"
+#include "trace.h"
 
 Program::Program(List<Decl*> *d) {
     Assert(d != NULL);
     (decls=d)->SetParentAll(this);
+    libraries = new List<Summary*>;
+}
+
+/*
+ * Read the summaries of the imported libraries and add their declarations
+ * in front of those of the program.
+ */
+void Program::Import() {
+    List<Decl*> *all = new List<Decl*>;
+    for (int i = 0; i < ctx->imports->NumElements(); i++) {
+        const char *file = ctx->imports->Nth(i);
+        Summary *s = Summary::Read(file);
+        if (!s) {
+            ReportError::Formatted(NULL, "Cannot read summary file %s.", file);
+            continue;
+        }
+        // the global vars of the libraries are apart.
+        for (int j = 0; j < libraries->NumElements(); j++) {
+            Summary *t = libraries->Nth(j);
+            if (s->GetGlobalBase() < t->GetGlobalEnd() &&
+                t->GetGlobalBase() < s->GetGlobalEnd()) {
+                ReportError::Formatted(NULL, "Libraries %s and %s use the "
+                        "same global vars.", t->GetFile(), file);
+            }
+        }
+        libraries->Append(s);
+        List<Decl*> *imported = s->GetDecls();
+        for (int j = 0; j < imported->NumElements(); j++) {
+            imported->Nth(j)->SetParent(this);
+            all->Append(imported->Nth(j));
+        }
+    }
+    for (int i = 0; i < decls->NumElements(); i++) {
+        all->Append(decls->Nth(i));
+    }
+    decls = all;
 }
 
 void Program::PrintChildren(int indentLevel) {
@@ -30,29 +69,62 @@ void Program::Check() {
      */
     if (IsDebugOn("ast")) { this->Print(0); }
 
-    /* Pass 1: Traverse the AST and build the symbol table. Report the
-     * errors of declaration conflict in any local scopes. */
-    symtab = new SymbolTable(); decls->CheckAll(E_BuildST);
-    if (IsDebugOn("st")) { symtab->Print(); }
-    PrintDebug("ast+", "BuildST finished.");
+    /* The declarations of the imported libraries are checked with those
+     * of the program, but not emitted. */
+    Stats::Start("import");
+    Import();
+
+    /* Pass 1: Traverse the declarations and build the symbol table of the
+     * globals, the classes, the interfaces and the formals. Report the
+     * errors of declaration conflict. The passes do not walk the function
+     * bodies, the bodies are checked at last, see CheckTasks. */
+    ctx->symtab = new SymbolTable(); ctx->typetab = new TypeTable();
+    ctx->checkTasks = new CheckTasks();
+    Stats::Start("BuildST");
+    decls->CheckAll(E_BuildST);
+    if (IsDebugOn("st")) { ctx->symtab->Print(); }
+    Trace(T_Passes, "BuildST finished.");
     if (IsDebugOn("ast+")) { this->Print(0); }
 
     /* Pass 2: Traverse the AST and report any errors of undeclared
      * identifiers except the field access and function calls. */
-    symtab->ReEnter(); decls->CheckAll(E_CheckDecl);
-    PrintDebug("ast+", "CheckDecl finished.");
+    Stats::Start("CheckDecl");
+    ctx->symtab->ReEnter(); decls->CheckAll(E_CheckDecl);
+    Trace(T_Passes, "CheckDecl finished.");
     if (IsDebugOn("ast+")) { this->Print(0); }
 
     /* Pass 3: Traverse the AST and report errors related to the class and
      * interface inheritance. */
-    symtab->ReEnter(); decls->CheckAll(E_CheckInherit);
-    PrintDebug("ast+", "CheckInherit finished.");
+    Stats::Start("CheckInherit");
+    ctx->symtab->ReEnter(); decls->CheckAll(E_CheckInherit);
+    Trace(T_Passes, "CheckInherit finished.");
     if (IsDebugOn("ast+")) { this->Print(0); }
 
+    /* Number the class hierarchy, so that the subtype tests in pass 4 and
+     * in the code generator are constant time. */
+    Stats::Start("layout");
+    ClassDecl::NumberHierarchy(decls);
+
+    /* Lay out the classes, the layouts are shared by pass 4 and the code
+     * generator. Report the classes with unimplemented interfaces. */
+    ClassDecl::LayoutClasses(decls);
+    for (int i = 0; i < libraries->NumElements(); i++) {
+        libraries->Nth(i)->CheckLayouts();
+    }
+
     /* Pass 4: Traverse the AST and report errors related to types, function
      * calls and field access. Actually, check all the remaining errors. */
-    symtab->ReEnter(); decls->CheckAll(E_CheckType);
-    PrintDebug("ast+", "CheckType finished.");
+    Stats::Start("CheckType");
+    ctx->symtab->ReEnter(); decls->CheckAll(E_CheckType);
+
+    /* Check each function body in one walk, which builds the scopes of the
+     * body and does the work of the passes above together. The bodies are
+     * checked in parallel, and the errors are reported in the order of the
+     * passes. */
+    Stats::Start("check bodies");
+    ctx->checkTasks->Run();
+    ctx->checkTasks = NULL;
+    Trace(T_Passes, "CheckType finished.");
     if (IsDebugOn("ast+")) { this->Print(0); }
 }
 
@@ -64,9 +136,10 @@ void Program::Emit() {
      *      which makes for a great use of inheritance and
      *      polymorphism in the node classes.
      */
+    Stats::Start("emit tac");
 
-    // Check if there exists a global main function.
-    bool has_main = false;
+    // Check if there exists a global main function, a library needs none.
+    bool has_main = ctx->summaryFile != NULL;
     for (int i = 0; i < decls->NumElements(); i++) {
         Decl *d = decls->Nth(i);
         if (d->IsFnDecl()) {
@@ -81,10 +154,30 @@ void Program::Emit() {
         return;
     }
 
-    PrintDebug("tac+", "Assign offset for class/interface members & global.");
-    // Assign offset for global var, class/interface members.
+    Trace(T_Emit, "Assign offset for class/interface members & global.");
+    // Assign offset for global var, class/interface members. The global
+    // vars of the libraries come first.
+    int globalBase = 0;
+    for (int i = 0; i < libraries->NumElements(); i++) {
+        if (libraries->Nth(i)->GetGlobalEnd() > globalBase)
+            globalBase = libraries->Nth(i)->GetGlobalEnd();
+    }
+    ctx->cg->ReserveGlobals(globalBase);
+    int numGlobals = 0;
     for (int i = 0; i < decls->NumElements(); i++) {
-        decls->Nth(i)->AssignOffset();
+        Decl *d = decls->Nth(i);
+        d->AssignOffset();
+        if (d->IsVarDecl()) numGlobals++;
+    }
+    // Write the summary of a library, its labels get a prefix of their own.
+    if (ctx->summaryFile) {
+        if (!Summary::Write(ctx->summaryFile, decls, globalBase,
+                            numGlobals * CodeGenerator::VarSize)) {
+            ReportError::Formatted(NULL, "Cannot write summary file %s.",
+                    ctx->summaryFile);
+            return;
+        }
+        ctx->labelPrefix = Summary::LabelPrefix(ctx->summaryFile);
     }
     // Add prefix for functions.
     for (int i = 0; i < decls->NumElements(); i++) {
@@ -92,12 +185,44 @@ void Program::Emit() {
     }
     if (IsDebugOn("tac+")) { this->Print(0); }
 
-    PrintDebug("tac+", "Begin Emitting TAC for Program.");
-    decls->EmitAll();
+    Trace(T_Emit, "Begin Emitting TAC for Program.");
+    // The checked program is read only, so the functions and methods are
+    // independent units, emitted in parallel and appended in order.
+    List<Decl*> *units = new List<Decl*>;
+    for (int i = 0; i < decls->NumElements(); i++) {
+        decls->Nth(i)->AddEmitUnits(units);
+    }
+    ctx->cg->EmitUnits(units);
     if (IsDebugOn("tac+")) { this->Print(0); }
+    // a program the back end cannot translate, such as one with doubles.
+    if (ctx->numErrors > 0) return;
+
+    // Emit the TAC or final MIPS assembly code, and link the code of the
+    // libraries. Those a library imports are linked into the program,
+    // which imports them too.
+    ctx->cg->DoFinalCodeGen();
+    if (ctx->summaryFile) return;
+    Stats::Start("link");
+    for (int i = 0; i < libraries->NumElements(); i++) {
+        libraries->Nth(i)->LinkCode();
+    }
+}
 
-    // Emit the TAC or final MIPS assembly code.
-    CG->DoFinalCodeGen();
+/*
+ * Check a part of a function body in the given pass, and report the errors
+ * of the pass, see CheckTasks.
+ */
+static void CheckPass(Node *n, checkT c) {
+    ctx->err = ctx->passErr[c];
+    n->Check(c);
+}
+
+/*
+ * The fused walk of a simple statement, which has no scopes.
+ */
+void Stmt::CheckBody() {
+    CheckPass(this, E_CheckDecl);
+    CheckPass(this, E_CheckType);
 }
 
 StmtBlock::StmtBlock(List<VarDecl*> *d, List<Stmt*> *s) {
@@ -112,21 +237,39 @@ void StmtBlock::PrintChildren(int indentLevel) {
 }
 
 void StmtBlock::BuildST() {
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     decls->CheckAll(E_BuildST);
     stmts->CheckAll(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void StmtBlock::Check(checkT c) {
     if (c == E_BuildST) {
         this->BuildST();
     } else {
-        symtab->EnterScope();
+        ctx->symtab->EnterScope();
         decls->CheckAll(c);
         stmts->CheckAll(c);
-        symtab->ExitScope();
+        ctx->symtab->ExitScope();
+    }
+}
+
+/*
+ * The variables of a block come before the statements, so the scope of the
+ * block is complete before any names are looked up in it.
+ */
+void StmtBlock::CheckBody() {
+    ctx->err = ctx->passErr[E_BuildST];
+    ctx->symtab->BuildScope();
+    decls->CheckAll(E_BuildST);
+    for (int i = 0; i < decls->NumElements(); i++) {
+        CheckPass(decls->Nth(i), E_CheckDecl);
+        CheckPass(decls->Nth(i), E_CheckType);
+    }
+    for (int i = 0; i < stmts->NumElements(); i++) {
+        stmts->Nth(i)->CheckBody();
     }
+    ctx->symtab->ExitScope();
 }
 
 void StmtBlock::Emit() {
@@ -140,6 +283,13 @@ ConditionalStmt::ConditionalStmt(Expr *t, Stmt *b) {
     (body=b)->SetParent(this);
 }
 
+void ConditionalStmt::CheckTest() {
+    test->Check(E_CheckType);
+    if (test->GetType() && test->GetType() != Type::boolType) {
+        ReportError::TestNotBoolean(test);
+    }
+}
+
 ForStmt::ForStmt(Expr *i, Expr *t, Expr *s, Stmt *b): LoopStmt(t, b) {
     Assert(i != NULL && t != NULL && s != NULL && b != NULL);
     (init=i)->SetParent(this);
@@ -154,21 +304,18 @@ void ForStmt::PrintChildren(int indentLevel) {
 }
 
 void ForStmt::BuildST() {
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     body->Check(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void ForStmt::CheckType() {
     init->Check(E_CheckType);
-    test->Check(E_CheckType);
-    if (test->GetType() && test->GetType() != Type::boolType) {
-        ReportError::TestNotBoolean(test);
-    }
+    this->CheckTest();
     step->Check(E_CheckType);
-    symtab->EnterScope();
+    ctx->symtab->EnterScope();
     body->Check(E_CheckType);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void ForStmt::Check(checkT c) {
@@ -181,28 +328,41 @@ void ForStmt::Check(checkT c) {
             init->Check(c);
             test->Check(c);
             step->Check(c);
-            symtab->EnterScope();
+            ctx->symtab->EnterScope();
             body->Check(c);
-            symtab->ExitScope();
+            ctx->symtab->ExitScope();
     }
 }
 
+void ForStmt::CheckBody() {
+    CheckPass(init, E_CheckDecl);
+    CheckPass(init, E_CheckType);
+    CheckPass(test, E_CheckDecl);
+    ctx->err = ctx->passErr[E_CheckType];
+    this->CheckTest();
+    CheckPass(step, E_CheckDecl);
+    CheckPass(step, E_CheckType);
+    ctx->symtab->BuildScope();
+    body->CheckBody();
+    ctx->symtab->ExitScope();
+}
+
 void ForStmt::Emit() {
     init->Emit();
 
-    const char *l0 = CG->NewLabel();
-    CG->GenLabel(l0);
+    const char *l0 = ctx->cg->NewLabel();
+    ctx->cg->GenLabel(l0);
     test->Emit();
     Location *t0 = test->GetEmitLocDeref();
-    const char *l1 = CG->NewLabel();
+    const char *l1 = ctx->cg->NewLabel();
     end_loop_label = l1;
-    CG->GenIfZ(t0, l1);
+    ctx->cg->GenIfZ(t0, l1);
 
     body->Emit();
     step->Emit();
-    CG->GenGoto(l0);
+    ctx->cg->GenGoto(l0);
 
-    CG->GenLabel(l1);
+    ctx->cg->GenLabel(l1);
 }
 
 void WhileStmt::PrintChildren(int indentLevel) {
@@ -211,19 +371,16 @@ void WhileStmt::PrintChildren(int indentLevel) {
 }
 
 void WhileStmt::BuildST() {
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     body->Check(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void WhileStmt::CheckType() {
-    test->Check(E_CheckType);
-    if (test->GetType() && test->GetType() != Type::boolType) {
-        ReportError::TestNotBoolean(test);
-    }
-    symtab->EnterScope();
+    this->CheckTest();
+    ctx->symtab->EnterScope();
     body->Check(E_CheckType);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void WhileStmt::Check(checkT c) {
@@ -234,26 +391,35 @@ void WhileStmt::Check(checkT c) {
             this->CheckType(); break;
         default:
             test->Check(c);
-            symtab->EnterScope();
+            ctx->symtab->EnterScope();
             body->Check(c);
-            symtab->ExitScope();
+            ctx->symtab->ExitScope();
     }
 }
 
+void WhileStmt::CheckBody() {
+    CheckPass(test, E_CheckDecl);
+    ctx->err = ctx->passErr[E_CheckType];
+    this->CheckTest();
+    ctx->symtab->BuildScope();
+    body->CheckBody();
+    ctx->symtab->ExitScope();
+}
+
 void WhileStmt::Emit() {
-    const char *l0 = CG->NewLabel();
-    CG->GenLabel(l0);
+    const char *l0 = ctx->cg->NewLabel();
+    ctx->cg->GenLabel(l0);
 
     test->Emit();
     Location *t0 = test->GetEmitLocDeref();
-    const char *l1 = CG->NewLabel();
+    const char *l1 = ctx->cg->NewLabel();
     end_loop_label = l1;
-    CG->GenIfZ(t0, l1);
+    ctx->cg->GenIfZ(t0, l1);
 
     body->Emit();
-    CG->GenGoto(l0);
+    ctx->cg->GenGoto(l0);
 
-    CG->GenLabel(l1);
+    ctx->cg->GenLabel(l1);
 }
 
 IfStmt::IfStmt(Expr *t, Stmt *tb, Stmt *eb): ConditionalStmt(t, tb) {
@@ -269,28 +435,25 @@ void IfStmt::PrintChildren(int indentLevel) {
 }
 
 void IfStmt::BuildST() {
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     body->Check(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
     if (elseBody) {
-        symtab->BuildScope();
+        ctx->symtab->BuildScope();
         elseBody->Check(E_BuildST);
-        symtab->ExitScope();
+        ctx->symtab->ExitScope();
     }
 }
 
 void IfStmt::CheckType() {
-    test->Check(E_CheckType);
-    if (test->GetType() && test->GetType() != Type::boolType) {
-        ReportError::TestNotBoolean(test);
-    }
-    symtab->EnterScope();
+    this->CheckTest();
+    ctx->symtab->EnterScope();
     body->Check(E_CheckType);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
     if (elseBody) {
-        symtab->EnterScope();
+        ctx->symtab->EnterScope();
         elseBody->Check(E_CheckType);
-        symtab->ExitScope();
+        ctx->symtab->ExitScope();
     }
 }
 
@@ -302,30 +465,44 @@ void IfStmt::Check(checkT c) {
             this->CheckType(); break;
         default:
             test->Check(c);
-            symtab->EnterScope();
+            ctx->symtab->EnterScope();
             body->Check(c);
-            symtab->ExitScope();
+            ctx->symtab->ExitScope();
             if (elseBody) {
-                symtab->EnterScope();
+                ctx->symtab->EnterScope();
                 elseBody->Check(c);
-                symtab->ExitScope();
+                ctx->symtab->ExitScope();
             }
     }
 }
 
+void IfStmt::CheckBody() {
+    CheckPass(test, E_CheckDecl);
+    ctx->err = ctx->passErr[E_CheckType];
+    this->CheckTest();
+    ctx->symtab->BuildScope();
+    body->CheckBody();
+    ctx->symtab->ExitScope();
+    if (elseBody) {
+        ctx->symtab->BuildScope();
+        elseBody->CheckBody();
+        ctx->symtab->ExitScope();
+    }
+}
+
 void IfStmt::Emit() {
     test->Emit();
     Location *t0 = test->GetEmitLocDeref();
-    const char *l0 = CG->NewLabel();
-    CG->GenIfZ(t0, l0);
+    const char *l0 = ctx->cg->NewLabel();
+    ctx->cg->GenIfZ(t0, l0);
 
     body->Emit();
-    const char *l1 = CG->NewLabel();
-    CG->GenGoto(l1);
+    const char *l1 = ctx->cg->NewLabel();
+    ctx->cg->GenGoto(l1);
 
-    CG->GenLabel(l0);
+    ctx->cg->GenLabel(l0);
     if (elseBody) elseBody->Emit();
-    CG->GenLabel(l1);
+    ctx->cg->GenLabel(l1);
 }
 
 void BreakStmt::Check(checkT c) {
@@ -345,13 +522,13 @@ void BreakStmt::Emit() {
     while (n->GetParent()) {
         if (n->IsLoopStmt()) {
             const char *l = dynamic_cast<LoopStmt*>(n)->GetEndLoopLabel();
-            PrintDebug("tac+", "endloop label %s.", l);
-            CG->GenGoto(l);
+            Trace(T_Emit, "endloop label %s.", l);
+            ctx->cg->GenGoto(l);
             return;
         } else if (n->IsSwitchStmt()) {
             const char *l = dynamic_cast<SwitchStmt*>(n)->GetEndSwitchLabel();
-            PrintDebug("tac+", "endswitch label %s.", l);
-            CG->GenGoto(l);
+            Trace(T_Emit, "endswitch label %s.", l);
+            ctx->cg->GenGoto(l);
             return;
         }
         n = n->GetParent();
@@ -372,9 +549,9 @@ void CaseStmt::PrintChildren(int indentLevel) {
 }
 
 void CaseStmt::BuildST() {
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     stmts->CheckAll(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void CaseStmt::Check(checkT c) {
@@ -382,18 +559,30 @@ void CaseStmt::Check(checkT c) {
         this->BuildST();
     } else {
         if (value) value->Check(c);
-        symtab->EnterScope();
+        ctx->symtab->EnterScope();
         stmts->CheckAll(c);
-        symtab->ExitScope();
+        ctx->symtab->ExitScope();
     }
 }
 
+void CaseStmt::CheckBody() {
+    if (value) {
+        CheckPass(value, E_CheckDecl);
+        CheckPass(value, E_CheckType);
+    }
+    ctx->symtab->BuildScope();
+    for (int i = 0; i < stmts->NumElements(); i++) {
+        stmts->Nth(i)->CheckBody();
+    }
+    ctx->symtab->ExitScope();
+}
+
 void CaseStmt::GenCaseLabel() {
-    case_label = CG->NewLabel();
+    case_label = ctx->cg->NewLabel();
 }
 
 void CaseStmt::Emit() {
-    CG->GenLabel(case_label);
+    ctx->cg->GenLabel(case_label);
     stmts->EmitAll();
 }
 
@@ -410,9 +599,9 @@ void SwitchStmt::PrintChildren(int indentLevel) {
 }
 
 void SwitchStmt::BuildST() {
-    symtab->BuildScope();
+    ctx->symtab->BuildScope();
     cases->CheckAll(E_BuildST);
-    symtab->ExitScope();
+    ctx->symtab->ExitScope();
 }
 
 void SwitchStmt::Check(checkT c) {
@@ -420,17 +609,27 @@ void SwitchStmt::Check(checkT c) {
         this->BuildST();
     } else {
         expr->Check(c);
-        symtab->EnterScope();
+        ctx->symtab->EnterScope();
         cases->CheckAll(c);
-        symtab->ExitScope();
+        ctx->symtab->ExitScope();
+    }
+}
+
+void SwitchStmt::CheckBody() {
+    CheckPass(expr, E_CheckDecl);
+    CheckPass(expr, E_CheckType);
+    ctx->symtab->BuildScope();
+    for (int i = 0; i < cases->NumElements(); i++) {
+        cases->Nth(i)->CheckBody();
     }
+    ctx->symtab->ExitScope();
 }
 
 void SwitchStmt::Emit() {
     expr->Emit();
 
     // the end_switch_label is used by break.
-    end_switch_label = CG->NewLabel();
+    end_switch_label = ctx->cg->NewLabel();
 
     Location *switch_value = expr->GetEmitLocDeref();
 
@@ -452,11 +651,11 @@ void SwitchStmt::Emit() {
             // case
             cv->Emit();
             Location *cvl = cv->GetEmitLocDeref();
-            Location *t = CG->GenBinaryOp("!=", switch_value, cvl);
-            CG->GenIfZ(t, cl);
+            Location *t = ctx->cg->GenBinaryOp("!=", switch_value, cvl);
+            ctx->cg->GenIfZ(t, cl);
         } else {
             // default
-            CG->GenGoto(cl);
+            ctx->cg->GenGoto(cl);
         }
     }
 
@@ -464,7 +663,7 @@ void SwitchStmt::Emit() {
     cases->EmitAll();
 
     // gen end_switch_label.
-    CG->GenLabel(end_switch_label);
+    ctx->cg->GenLabel(end_switch_label);
 }
 
 ReturnStmt::ReturnStmt(yyltype loc, Expr *e) : Stmt(loc) {
@@ -497,10 +696,10 @@ void ReturnStmt::Check(checkT c) {
 
 void ReturnStmt::Emit() {
     if (expr->IsEmptyExpr()) {
-        CG->GenReturn();
+        ctx->cg->GenReturn();
     } else {
         expr->Emit();
-        CG->GenReturn(expr->GetEmitLocDeref());
+        ctx->cg->GenReturn(expr->GetEmitLocDeref());
     }
 }
 
@@ -541,7 +740,7 @@ void PrintStmt::Emit() {
         }
         Location *l = args->Nth(i)->GetEmitLocDeref();
         Assert(l);
-        CG->GenBuiltInCall(f, l);
+        ctx->cg->GenBuiltInCall(f, l);
     }
 }
 
@@ -25,12 +25,16 @@
 
 class Decl;
 class VarDecl;
+class Summary;
 class Expr;
 
 class Program : public Node
 {
   protected:
     List<Decl*> *decls;
+    List<Summary*> *libraries;      // imported, see summary.h.
+
+    void Import();
 
   public:
     // constructor.
@@ -51,6 +55,8 @@ class Stmt : public Node
     // constructor.
     Stmt() : Node() {}
     Stmt(yyltype loc) : Node(loc) {}
+    // semantic check stuff.
+    virtual void CheckBody();   // the fused walk of a function body.
 };
 
 class StmtBlock : public Stmt
@@ -67,6 +73,7 @@ class StmtBlock : public Stmt
     void PrintChildren(int indentLevel);
     // semantic check stuff.
     void Check(checkT c);
+    void CheckBody();
     // code generation stuff.
     void Emit();
 
@@ -84,6 +91,9 @@ class ConditionalStmt : public Stmt
   public:
     // constructor.
     ConditionalStmt(Expr *testExpr, Stmt *body);
+
+  protected:
+    void CheckTest();
 };
 
 class LoopStmt : public ConditionalStmt
@@ -114,6 +124,7 @@ class ForStmt : public LoopStmt
     void PrintChildren(int indentLevel);
     // semantic check stuff.
     void Check(checkT c);
+    void CheckBody();
     // code generation stuff.
     void Emit();
 
@@ -132,6 +143,7 @@ class WhileStmt : public LoopStmt
     void PrintChildren(int indentLevel);
     // semantic check stuff.
     void Check(checkT c);
+    void CheckBody();
     // code generation stuff.
     void Emit();
 
@@ -153,6 +165,7 @@ class IfStmt : public ConditionalStmt
     void PrintChildren(int indentLevel);
     // semantic check stuff.
     void Check(checkT c);
+    void CheckBody();
     // code generation stuff.
     void Emit();
 
@@ -191,6 +204,7 @@ class CaseStmt : public Stmt
     void PrintChildren(int indentLevel);
     // semantic check stuff.
     void Check(checkT c);
+    void CheckBody();
     bool IsCaseStmt() { return value ? true : false; }
     // code generation stuff.
     void Emit();
@@ -217,6 +231,7 @@ class SwitchStmt : public Stmt
     void PrintChildren(int indentLevel);
     // semantic check stuff.
     void Check(checkT c);
+    void CheckBody();
     // code generation stuff.
     void Emit();
     bool IsSwitchStmt() { return true; }
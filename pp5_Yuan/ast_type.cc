@@ -9,6 +9,8 @@
 #include "ast_decl.h"
 #include "ast_type.h"
 #include "errors.h"
+#include "stats.h"
+#include "trace.h"
 
 /* Class constants
  * ---------------
@@ -28,8 +30,8 @@ Type *Type::errorType  = new Type("error");
 
 Type::Type(const char *n) {
     Assert(n);
-    typeName = strdup(n);
-    expr_type = NULL;
+    typeName = CopyString(n);
+    expr_type = this; // basic types are canonical by themselves.
 }
 
 void Type::PrintChildren(int indentLevel) {
@@ -39,14 +41,8 @@ void Type::PrintChildren(int indentLevel) {
 }
 
 void Type::Check(checkT c) {
-    if (c == E_CheckDecl) {
-        Type::intType->SetSelfType();
-        Type::doubleType->SetSelfType();
-        Type::voidType->SetSelfType();
-        Type::boolType->SetSelfType();
-        Type::nullType->SetSelfType();
-        Type::stringType->SetSelfType();
-        Type::errorType->SetSelfType();
+    // the basic types are their own type since they are constructed.
+    if (c == E_CheckDecl && expr_type != this) {
         expr_type = this;
     }
 }
@@ -63,7 +59,7 @@ void NamedType::PrintChildren(int indentLevel) {
 }
 
 void NamedType::CheckDecl(reasonT r) {
-    Decl *d = symtab->Lookup(this->id);
+    Decl *d = ctx->symtab->Lookup(this->id);
     if (d == NULL || (!d->IsClassDecl() && !d->IsInterfaceDecl())) {
         ReportError::IdentifierNotDeclared(this->id, r);
     } else if (r == LookingForClass && !d->IsClassDecl()) {
@@ -72,7 +68,7 @@ void NamedType::CheckDecl(reasonT r) {
         ReportError::IdentifierNotDeclared(this->id, r);
     } else {
         this->id->SetDecl(d);
-        expr_type = this;
+        expr_type = ctx->typetab->GetNamedType(d);
     }
 }
 
@@ -84,17 +80,6 @@ void NamedType::Check(checkT c, reasonT r) {
     }
 }
 
-bool NamedType::IsEquivalentTo(Type *other) {
-    Assert(this->GetType() && other->GetType());
-
-    if (!other->IsNamedType()) {
-        return false;
-    } else {
-        NamedType * nt = dynamic_cast<NamedType*>(other);
-        return (id->IsEquivalentTo(nt->GetId()));
-    }
-}
-
 /* NamedType A IsCompatibleWith NamedType B,
  * means that A = B,
  * or class B is the subclass of class A,
@@ -110,16 +95,10 @@ bool NamedType::IsCompatibleWith(Type *other) {
     } else if (this->IsEquivalentTo(other)) {
         return true;
     } else {
-        NamedType * nt = dynamic_cast<NamedType*>(other);
-        Decl *decl1 = id->GetDecl();
-        Decl *decl2 = nt->GetId()->GetDecl();
-        Assert(decl1 && decl2);
-        if (!decl2->IsClassDecl()) {
-            return false;
-        }
-        ClassDecl *cdecl2 = dynamic_cast<ClassDecl*>(decl2);
         // subclass can compatible with its parent class and interface.
-        return cdecl2->IsChildOf(decl1);
+        return ctx->typetab->IsSubtype(
+                dynamic_cast<NamedType*>(this->GetType()),
+                dynamic_cast<NamedType*>(other->GetType()));
     }
 }
 
@@ -127,6 +106,13 @@ ArrayType::ArrayType(yyltype loc, Type *et) : Type(loc) {
     Assert(et != NULL);
     (elemType=et)->SetParent(this);
 }
+
+ArrayType::ArrayType(Type *et) : Type() {
+    Assert(et != NULL);
+    // the canonical element type is shared, so do not take it as a child.
+    elemType = et;
+    expr_type = this;
+}
 void ArrayType::PrintChildren(int indentLevel) {
     if (expr_type) std::cout << " <" << expr_type << ">";
     if (emit_loc) emit_loc->Print();
@@ -136,7 +122,7 @@ void ArrayType::PrintChildren(int indentLevel) {
 void ArrayType::CheckDecl() {
     elemType->Check(E_CheckDecl);
     if (elemType->GetType()) {
-        expr_type = this;
+        expr_type = ctx->typetab->GetArrayType(elemType->GetType());
     }
 }
 
@@ -148,24 +134,11 @@ void ArrayType::Check(checkT c) {
     }
 }
 
-bool ArrayType::IsEquivalentTo(Type *other) {
-    Assert(this->GetType() && other->GetType());
-
-    if (!other->IsArrayType()) {
-        return false;
-    } else {
-        ArrayType * nt = dynamic_cast<ArrayType*>(other);
-        return (elemType->IsEquivalentTo(nt->GetElemType()));
-    }
-}
-
 
 
 
 
 
-SymbolTable *symtab;
-
 /* Scope class, maintain the necessary information of scope structure.
  */
 class Scope
@@ -205,11 +178,12 @@ class Scope
 /* Implementation of Symbol Table
  */
 SymbolTable::SymbolTable() {
-    PrintDebug("sttrace", "SymbolTable constructor.\n");
+    Trace(T_SymbolTable, "SymbolTable constructor.\n");
     /* Init the global scope. */
     scopes = new std::vector<Scope *>;
     scopes->clear();
     scopes->push_back(new Scope());
+    locals = NULL;
 
     /* Init the active scopes, and active global scope 0. */
     activeScopes = new std::vector<int>;
@@ -226,7 +200,7 @@ SymbolTable::SymbolTable() {
  * Resert symbol table counter and active scopes for another pass.
  */
 void SymbolTable::ReEnter() {
-    PrintDebug("sttrace", "======== Reenter SymbolTable ========\n");
+    Trace(T_SymbolTable, "======== Reenter SymbolTable ========\n");
     activeScopes->clear();
     activeScopes->push_back(0);
 
@@ -235,34 +209,61 @@ void SymbolTable::ReEnter() {
     id_cnt = 0;
 }
 
+/*
+ * Return a copy of the current position in the walk, sharing the scopes.
+ */
+SymbolTable * SymbolTable::Fork() {
+    SymbolTable *t = new SymbolTable(*this);
+    t->locals = new std::vector<Scope *>;
+    t->activeScopes = new std::vector<int>(*activeScopes);
+    return t;
+}
+
+/*
+ * The scopes of a fork are numbered after the shared scopes.
+ */
+Scope * SymbolTable::GetScope(int i) {
+    int n = scopes->size();
+    return i < n ? scopes->at(i) : locals->at(i - n);
+}
+
+int SymbolTable::AddScope(Scope *s) {
+    Stats::Count(Stats::Scopes);
+    if (locals) {
+        locals->push_back(s);
+        return scopes->size() + locals->size() - 1;
+    }
+    scopes->push_back(s);
+    return ++scope_cnt;
+}
+
 /*
  * Enter a new scope.
  */
 void SymbolTable::BuildScope() {
-    PrintDebug("sttrace", "Build new scope %d.\n", scope_cnt + 1);
-    scope_cnt++;
-    scopes->push_back(new Scope());
-    activeScopes->push_back(scope_cnt);
-    cur_scope = scope_cnt;
+    int scope = AddScope(new Scope());
+    Trace(T_SymbolTable, "Build new scope %d.\n", scope);
+    activeScopes->push_back(scope);
+    cur_scope = scope;
 }
 
 /*
  * Enter a new scope, and set owner for class and interface.
  */
 void SymbolTable::BuildScope(const char *key) {
-    PrintDebug("sttrace", "Build new scope %d.\n", scope_cnt + 1);
-    scope_cnt++;
-    scopes->push_back(new Scope());
-    scopes->at(scope_cnt)->SetOwner(key);
-    activeScopes->push_back(scope_cnt);
-    cur_scope = scope_cnt;
+    Scope *s = new Scope();
+    s->SetOwner(key);
+    int scope = AddScope(s);
+    Trace(T_SymbolTable, "Build new scope %d.\n", scope);
+    activeScopes->push_back(scope);
+    cur_scope = scope;
 }
 
 /*
  * Enter a new scope.
  */
 void SymbolTable::EnterScope() {
-    PrintDebug("sttrace", "Enter scope %d.\n", scope_cnt + 1);
+    Trace(T_SymbolTable, "Enter scope %d.\n", scope_cnt + 1);
     scope_cnt++;
     activeScopes->push_back(scope_cnt);
     cur_scope = scope_cnt;
@@ -283,7 +284,7 @@ int SymbolTable::FindScopeFromOwnerName(const char *key) {
         }
     }
 
-    PrintDebug("sttrace", "From %s find scope %d.\n", key, scope);
+    Trace(T_SymbolTable, "From %s find scope %d.\n", key, scope);
     return scope;
 }
 
@@ -294,7 +295,7 @@ Decl * SymbolTable::Lookup(Identifier *id) {
     Decl *d = NULL;
     const char *parent = NULL;
     const char *key = id->GetIdName();
-    PrintDebug("sttrace", "Lookup %s from active scopes %d.\n", key, cur_scope);
+    Trace(T_SymbolTable, "Lookup %s from active scopes %d.\n", key, cur_scope);
 
     //printf("Look up %s from scope %d\n", key, cur_scope);
 
@@ -302,7 +303,7 @@ Decl * SymbolTable::Lookup(Identifier *id) {
     for (int i = activeScopes->size(); i > 0; --i) {
 
         int scope = activeScopes->at(i-1);
-        Scope *s = scopes->at(scope);
+        Scope *s = GetScope(scope);
 
         if (s->HasHT()) {
             d = s->GetHT()->Lookup(key);
@@ -340,11 +341,12 @@ Decl * SymbolTable::LookupParent(Identifier *id) {
     Decl *d = NULL;
     const char *parent = NULL;
     const char *key = id->GetIdName();
-    Scope *s = scopes->at(cur_scope);
-    PrintDebug("sttrace", "Lookup %s in parent of %d.\n", key, cur_scope);
+    Scope *s = GetScope(cur_scope);
+    Trace(T_SymbolTable, "Lookup %s in parent of %d.\n", key, cur_scope);
 
-    // Look up parent scopes.
-    while (s->HasParent()) {
+    // Look up parent scopes, up to an undeclared parent. A chain without
+    // a loop has each scope once at most.
+    for (size_t n = 0; s->HasParent() && n < scopes->size(); n++) {
         parent = s->GetParent();
         int scope = FindScopeFromOwnerName(parent);
         //printf("Look up %s from %s\n", key, parent);
@@ -360,6 +362,8 @@ Decl * SymbolTable::LookupParent(Identifier *id) {
                 }
                 if (d != NULL) break;
             }
+        } else {
+            break;
         }
     }
 
@@ -373,8 +377,8 @@ Decl * SymbolTable::LookupInterface(Identifier *id) {
     Decl *d = NULL;
     const char *key = id->GetIdName();
     int scope;
-    Scope *s = scopes->at(cur_scope);
-    PrintDebug("sttrace", "Lookup %s in interface of %d.\n", key, cur_scope);
+    Scope *s = GetScope(cur_scope);
+    Trace(T_SymbolTable, "Lookup %s in interface of %d.\n", key, cur_scope);
 
     // Look up interface scopes.
     if (s->HasInterface()) {
@@ -405,7 +409,16 @@ Decl * SymbolTable::LookupField(Identifier *base, Identifier *field) {
     Decl *d = NULL;
     const char *b = base->GetIdName();
     const char *f = field->GetIdName();
-    PrintDebug("sttrace", "Lookup %s from field %s\n", f, b);
+    Trace(T_SymbolTable, "Lookup %s from field %s\n", f, b);
+
+    // a numbered class has its members laid out, inherited ones included.
+    Decl *bd = base->GetDecl();
+    if (bd && bd->IsClassDecl()) {
+        ClassDecl *c = dynamic_cast<ClassDecl*>(bd);
+        if (c->GetLayout() && c->GetPreOrder() != -1) {
+            return c->GetLayout()->LookupMember(f);
+        }
+    }
 
     // find scope from field name.
     int scope = FindScopeFromOwnerName(b);
@@ -418,8 +431,8 @@ Decl * SymbolTable::LookupField(Identifier *base, Identifier *field) {
     }
     if (d != NULL) return d;
 
-    // lookup the parent.
-    while (s->HasParent()) {
+    // lookup the parent, see LookupParent.
+    for (size_t n = 0; s->HasParent() && n < scopes->size(); n++) {
         b = s->GetParent();
         scope = FindScopeFromOwnerName(b);
         if (scope != -1) {
@@ -444,16 +457,16 @@ Decl * SymbolTable::LookupField(Identifier *base, Identifier *field) {
  * Look up the class decl for This.
  */
 Decl * SymbolTable::LookupThis() {
-    PrintDebug("sttrace", "Lookup This\n");
+    Trace(T_SymbolTable, "Lookup This\n");
     Decl *d = NULL;
     // Look up all the active scopes.
     for (int i = activeScopes->size(); i > 0; --i) {
 
         int scope = activeScopes->at(i-1);
-        Scope *s = scopes->at(scope);
+        Scope *s = GetScope(scope);
 
         if (s->HasOwner()) {
-            PrintDebug("sttrace", "Lookup This as %s\n", s->GetOwner());
+            Trace(T_SymbolTable, "Lookup This as %s\n", s->GetOwner());
             // Look up scope 0 to find the class decl.
             Scope *s0 = scopes->at(0);
             if (s0->HasHT()) {
@@ -470,14 +483,15 @@ Decl * SymbolTable::LookupThis() {
  */
 int SymbolTable::InsertSymbol(Decl *decl) {
     const char *key = decl->GetId()->GetIdName();
-    Scope *s = scopes->at(cur_scope);
-    PrintDebug("sttrace", "Insert %s to scope %d\n", key, cur_scope);
+    Scope *s = GetScope(cur_scope);
+    Trace(T_SymbolTable, "Insert %s to scope %d\n", key, cur_scope);
 
     if (!s->HasHT()) {
         s->BuildHT();
     }
 
     s->GetHT()->Enter(key, decl);
+    Stats::Count(Stats::Symbols);
     return id_cnt++;
 }
 
@@ -487,8 +501,8 @@ int SymbolTable::InsertSymbol(Decl *decl) {
 bool SymbolTable::LocalLookup(Identifier *id) {
     Decl *d = NULL;
     const char *key = id->GetIdName();
-    Scope *s = scopes->at(cur_scope);
-    PrintDebug("sttrace", "LocalLookup %s from scope %d\n", key, cur_scope);
+    Scope *s = GetScope(cur_scope);
+    Trace(T_SymbolTable, "LocalLookup %s from scope %d\n", key, cur_scope);
 
     if (s->HasHT()) {
         d = s->GetHT()->Lookup(key);
@@ -501,7 +515,7 @@ bool SymbolTable::LocalLookup(Identifier *id) {
  * Exit current scope and return to its uplevel scope.
  */
 void SymbolTable::ExitScope() {
-    PrintDebug("sttrace", "Exit scope %d\n", cur_scope);
+    Trace(T_SymbolTable, "Exit scope %d\n", cur_scope);
     activeScopes->pop_back();
     cur_scope = activeScopes->back();
 }
@@ -510,14 +524,14 @@ void SymbolTable::ExitScope() {
  * Deal with class inheritance, set parent for a subclass.
  */
 void SymbolTable::SetScopeParent(const char *key) {
-    scopes->at(cur_scope)->SetParent(key);
+    GetScope(cur_scope)->SetParent(key);
 }
 
 /*
  * Deal with class interface, set interfaces for a subclass.
  */
 void SymbolTable::SetInterface(const char *key) {
-    scopes->at(cur_scope)->AddInterface(key);
+    GetScope(cur_scope)->AddInterface(key);
 }
 
 /*
@@ -560,3 +574,57 @@ void SymbolTable::Print() {
     std::cout << "======== Symbol Table ========" << std::endl;
 }
 
+
+
+
+
+/* Implementation of Type Table
+ */
+TypeTable::TypeTable() {
+    named = new Hashtable<NamedType*>;
+    arrays = new std::map<Type*, ArrayType*>;
+}
+
+/*
+ * Return the canonical named type for a class or interface decl.
+ */
+NamedType * TypeTable::GetNamedType(Decl *decl) {
+    const char *key = decl->GetId()->GetIdName();
+    std::lock_guard<std::mutex> guard(lock);
+    NamedType *t = named->Lookup(key);
+    if (t == NULL) {
+        Trace(T_SymbolTable, "Intern named type %s.\n", key);
+        Identifier *i = new Identifier(*decl->GetLocation(), key);
+        i->SetDecl(decl);
+        t = new NamedType(i);
+        t->SetSelfType();
+        named->Enter(key, t);
+    }
+    return t;
+}
+
+/*
+ * Return the canonical array type whose elements are elem.
+ */
+ArrayType * TypeTable::GetArrayType(Type *elem) {
+    Assert(elem && elem == elem->GetType());
+    std::lock_guard<std::mutex> guard(lock);
+    std::map<Type*, ArrayType*>::iterator it = arrays->find(elem);
+    if (it != arrays->end()) return it->second;
+
+    ArrayType *t = new ArrayType(elem);
+    arrays->insert(std::make_pair(elem, t));
+    return t;
+}
+
+/*
+ * Return true if b is a subclass of a, or b or its parents implement a.
+ * The class hierarchy numbering makes this a constant time test.
+ */
+bool TypeTable::IsSubtype(NamedType *a, NamedType *b) {
+    Decl *decl1 = a->GetId()->GetDecl();
+    Decl *decl2 = b->GetId()->GetDecl();
+    Assert(decl1 && decl2);
+    return decl2->IsClassDecl()
+        && dynamic_cast<ClassDecl*>(decl2)->IsChildOf(decl1);
+}
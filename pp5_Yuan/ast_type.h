@@ -21,6 +21,8 @@
 
 
 #include <list>
+#include <map>
+#include <mutex>
 #include <vector>
 #include "hashtable.h"
 #include "ast.h"
@@ -38,6 +40,10 @@ class Type : public Node
     // constructor.
     Type(yyltype loc) : Node(loc) { expr_type = NULL; }
     Type(const char *str);
+    Type() : Node() { typeName = NULL; expr_type = NULL; }
+    // the basic types are shared by all the compilations in the process,
+    // so they are never modified and have no parent.
+    void SetParent(Node *p) { if (!IsBasicType()) Node::SetParent(p); }
     // print stuff.
     const char *GetPrintNameForNode() { return "Type"; }
     void PrintChildren(int indentLevel);
@@ -50,8 +56,12 @@ class Type : public Node
     virtual bool IsBasicType() { return !IsNamedType() && !IsArrayType(); }
     virtual bool IsNamedType() { return false; }
     virtual bool IsArrayType() { return false; }
-    virtual bool IsEquivalentTo(Type *other) { return this == other; }
-    virtual bool IsCompatibleWith(Type *other) { return this == other; }
+    // all checked types are interned, so equivalence is a pointer compare.
+    bool IsEquivalentTo(Type *other) {
+        Assert(this->GetType() && other->GetType());
+        return this->GetType() == other->GetType();
+    }
+    virtual bool IsCompatibleWith(Type *other) { return IsEquivalentTo(other); }
     char * GetTypeName() { return typeName; }
     virtual void SetSelfType() { expr_type = this; }
     // code generation stuff.
@@ -74,7 +84,6 @@ class NamedType : public Type
     void Check(checkT c, reasonT r);
     void Check(checkT c) { Check(c, LookingForType); }
     bool IsNamedType() { return true; }
-    bool IsEquivalentTo(Type *other);
     bool IsCompatibleWith(Type *other);
     Identifier *GetId() { return id; }
 
@@ -90,6 +99,7 @@ class ArrayType : public Type
   public:
     // constructor.
     ArrayType(yyltype loc, Type *elemType);
+    ArrayType(Type *elemType); // canonical array type, see TypeTable.
     // print stuff.
     const char *GetPrintNameForNode() { return "ArrayType"; }
     void PrintChildren(int indentLevel);
@@ -97,7 +107,6 @@ class ArrayType : public Type
     // semantic check stuff.
     void Check(checkT c);
     bool IsArrayType() { return true; }
-    bool IsEquivalentTo(Type *other);
     Type * GetElemType() { return elemType->GetType(); }
 
   protected:
@@ -106,7 +115,6 @@ class ArrayType : public Type
 
 
 
-
 /* Symbol Table Implementation. */
 
 class Decl;
@@ -117,6 +125,7 @@ class SymbolTable
 {
   protected:
     std::vector<Scope *> *scopes;
+    std::vector<Scope *> *locals;   /* the scopes of a fork, see Fork */
     std::vector<int> *activeScopes;
     int cur_scope;  /* current scope */
     int scope_cnt;  /* scope counter */
@@ -156,15 +165,53 @@ class SymbolTable
     /* Resert symbol table counter and active scopes for another pass. */
     void ReEnter();
 
+    /* Return a copy of the current position in the walk, which shares the
+     * scopes built so far and keeps the scopes it builds to itself. The
+     * shared scopes are not changed after the first pass, so each copy can
+     * walk a function body on its own thread. */
+    SymbolTable *Fork();
+
     /* Print the whole symbol table. */
     void Print();
 
   protected:
     int FindScopeFromOwnerName(const char *owner);
+    /* The scope of the given number, shared or built by this fork. */
+    Scope *GetScope(int i);
+    /* Append a new scope and return its number. */
+    int AddScope(Scope *s);
 
 };
 
-extern SymbolTable *symtab;
+
+
+
+
+/* Type Table Implementation. */
+
+/* Every distinct type (basic, named class/interface, array of T) is interned
+ * here and exists exactly once, so the type checker can compare types by
+ * pointer. The subtype test uses the numbering of the class hierarchy.
+ */
+class TypeTable
+{
+  protected:
+    Hashtable<NamedType*> *named;           // class/interface name -> type
+    std::map<Type*, ArrayType*> *arrays;    // element type -> array type
+    std::mutex lock;                        // the functions are checked in
+                                            // parallel, see CheckTasks.
+
+  public:
+    TypeTable();
+
+    /* Return the canonical named type for a class or interface decl. */
+    NamedType *GetNamedType(Decl *decl);
+    /* Return the canonical array type whose elements are elem. */
+    ArrayType *GetArrayType(Type *elem);
+    /* Return true if named type b can be used where named type a is
+     * expected, i.e. b is a subclass of a or implements interface a. */
+    bool IsSubtype(NamedType *a, NamedType *b);
+};
 
 #endif
 
@@ -0,0 +1,148 @@
+/* File: batch.cc
+ * --------------
+ * Implementation of BatchCompiler.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "arena.h"
+#include "context.h"
+#include "scanner.h"
+
+static std::mutex batchLock;
+
+BatchCompiler::BatchCompiler() {
+    debugKeys = new List<const char*>;
+    jobs = new List<Job*>;
+    numThreads = 0;
+    nextJob = 0;
+}
+
+static void BatchUsage() {
+    printf("Usage:   --batch <file> ... [-j <jobs>] "
+           "[-d <debug-key-1> <debug-key-2> ...]\n");
+    exit(2);
+}
+
+/*
+ * The assembly of foo.decaf goes to foo.asm, other names get a .asm suffix.
+ */
+static std::string AsmFileFor(const char *file) {
+    std::string name(file);
+    size_t len = strlen(".decaf");
+    if (name.size() > len && name.compare(name.size() - len, len,
+                                          ".decaf") == 0)
+        name.erase(name.size() - len);
+    return name + ".asm";
+}
+
+void BatchCompiler::ParseCommandLine(int argc, char *argv[]) {
+    int i = 1;
+    Assert(i < argc && strcmp(argv[i], "--batch") == 0);
+    for (i++; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0) {
+            if (++i == argc || (numThreads = atoi(argv[i])) <= 0)
+                BatchUsage();
+        } else if (strcmp(argv[i], "-d") == 0) {
+            for (i++; i < argc; i++)
+                debugKeys->Append(argv[i]);
+        } else if (argv[i][0] == '-') {
+            BatchUsage();
+        } else {
+            Job *job = new Job;
+            job->inputFile = argv[i];
+            job->asmFile = AsmFileFor(argv[i]);
+            job->numErrors = 0;
+            jobs->Append(job);
+        }
+    }
+    if (jobs->NumElements() == 0) BatchUsage();
+    if (numThreads == 0) {
+        // one thread per core by default.
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        numThreads = cores > 0 ? cores : 1;
+    }
+}
+
+/*
+ * Compile one file in a context of its own, the assembly goes to the .asm
+ * file and the error messages are kept until all the files are done. All
+ * of the compilation is allocated in an arena, freed with the mapping of
+ * the input once the file is done, so a batch of many files does not
+ * grow; only the messages are copied out of it.
+ */
+void BatchCompiler::Compile(Job *job) {
+    Arena *arena = new Arena();
+    Arena::current = arena;
+    {
+        CompilationContext c;
+        c.inputFile = job->inputFile;
+        for (int i = 0; i < debugKeys->NumElements(); i++)
+            c.debugKeys->Append(debugKeys->Nth(i));
+        std::ostringstream err;
+        c.err = &err;
+
+        c.out = fopen(job->asmFile.c_str(), "w");
+        if (!c.out) {
+            err << "Cannot write output file " << job->asmFile << std::endl;
+            job->numErrors = -1;
+        } else {
+            job->numErrors = c.Compile();
+            fclose(c.out);
+            UnloadInput(&c);
+            if (job->numErrors != 0) unlink(job->asmFile.c_str());
+        }
+        Arena::current = NULL;
+        job->diagnostics = err.str();
+    }
+    arena->Release();
+}
+
+/*
+ * The loop of a worker thread, takes the jobs in order until none is left.
+ */
+void BatchCompiler::Work() {
+    while (true) {
+        Job *job;
+        {
+            std::lock_guard<std::mutex> guard(batchLock);
+            if (nextJob == jobs->NumElements()) return;
+            job = jobs->Nth(nextJob++);
+        }
+        Compile(job);
+    }
+}
+
+int BatchCompiler::Run() {
+    int n = numThreads < jobs->NumElements() ? numThreads
+                                              : jobs->NumElements();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < n; i++)
+        workers.push_back(std::thread(&BatchCompiler::Work, this));
+    for (int i = 0; i < n; i++)
+        workers[i].join();
+
+    // report the diagnostics grouped by file, in the order of the files.
+    int status = 0;
+    for (int i = 0; i < jobs->NumElements(); i++) {
+        Job *job = jobs->Nth(i);
+        if (!job->diagnostics.empty()) {
+            fprintf(stderr, "==> %s <==\n%s", job->inputFile,
+                    job->diagnostics.c_str());
+        }
+        if (job->numErrors < 0)
+            status = 2;
+        else if (job->numErrors > 0 && status == 0)
+            status = -1;
+    }
+    return status;
+}
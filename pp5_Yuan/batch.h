@@ -0,0 +1,52 @@
+/* File: batch.h
+ * -------------
+ * The BatchCompiler compiles many Decaf files in one process:
+ *
+ *    dcc --batch <file-1> <file-2> ... [-j <jobs>] [-d <debug-key> ...]
+ *
+ * Each file is compiled on a worker thread with its own compilation
+ * context, so the jobs share nothing but the read-only tables. The
+ * assembly of foo.decaf goes to foo.asm (removed again if the file has
+ * errors), the diagnostics of each file are collected and printed
+ * together under the name of the file, in the order of the command line.
+ * The exit status is 0 if all the files compiled, 2 if some file cannot
+ * be read, and -1 if some file has errors, as for a single file.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_batch
+#define _H_batch
+
+#include <string>
+#include "list.h"
+
+class BatchCompiler
+{
+  protected:
+    // the result of one file.
+    struct Job {
+        const char *inputFile;
+        std::string asmFile;
+        std::string diagnostics;
+        int numErrors;              // -1 if the input cannot be read.
+    };
+
+    List<const char*> *debugKeys;
+    List<Job*> *jobs;
+    int numThreads;
+    int nextJob;                    // the next job to take, see Work.
+
+    void Compile(Job *job);
+    void Work();
+
+  public:
+    // constructor.
+    BatchCompiler();
+    // the arguments after --batch.
+    void ParseCommandLine(int argc, char *argv[]);
+    // compile all the files, returns the exit status.
+    int Run();
+};
+
+#endif
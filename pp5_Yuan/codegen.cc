@@ -7,12 +7,29 @@
 
 #include "codegen.h"
 #include <string.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "tac.h"
-#include "mips.h"
+#include "target.h"
+#include "interp.h"
+#include "hashtable.h"
+#include "context.h"
+#include "ast_decl.h"
+#include "unitcache.h"
+#include "profile.h"
+#include "stats.h"
+#include "trace.h"
+#include "errors.h"
 
 Location* CodeGenerator::ThisPtr = new Location(fpRelative, 4, "this");
 
 CodeGenerator::CodeGenerator() {
+    labels = new List<char*>;
+    temps = new List<Location*>;
     local_loc = OffsetToFirstLocal;     // -8, -12, -16, ...
     param_loc = OffsetToFirstParam;     // 4, 8, 12, ...
     globl_loc = OffsetToFirstGlobal;    // 0, 4, 8, ...
@@ -40,41 +57,124 @@ int CodeGenerator::GetFrameSize() {
     return OffsetToFirstLocal - local_loc;
 }
 
+void CodeGenerator::ReserveGlobals(int end) {
+    if (globl_loc < end) globl_loc = end;
+}
+
 void CodeGenerator::ResetFrameSize() {
     local_loc = OffsetToFirstLocal;
     param_loc = OffsetToFirstParam;
 }
 
+static const int LabelSize = 48;   // "_L" and "_tmp" with an int and a
+                                   // label prefix, see summary.h.
+
 char *CodeGenerator::NewLabel() {
-    static int nextLabelNum = 0;
-    char temp[10];
-    sprintf(temp, "_L%d", nextLabelNum++);
-    return strdup(temp);
+    // the label is renamed in place by Append.
+    char *label = new char[LabelSize];
+    sprintf(label, "_L%d", labels->NumElements());
+    labels->Append(label);
+    return label;
 }
 
 Location *CodeGenerator::GenTempVar() {
-    static int nextTempNum;
-    char temp[10];
+    char temp[LabelSize];
     Location *result = NULL;
-    sprintf(temp, "_tmp%d", nextTempNum++);
+    sprintf(temp, "_tmp%d", temps->NumElements());
+    Stats::Count(Stats::Temps);
     /* pp5: need to create variable in proper location
        in stack frame for use as temporary. Until you
        do that, the assert below will always fail to remind
        you this needs to be implemented  */
     result = new Location(fpRelative, GetNextLocalLoc(), temp);
     Assert(result != NULL);
+    temps->Append(result);
     return result;
 }
 
+/*
+ * Emit one unit in a copy of the context with a code generator of its own.
+ * The errors of the unit are kept until all the units are emitted.
+ */
+static void EmitUnit(CompilationContext *parent, Decl *unit,
+                     CodeGenerator *cg, int *numErrors, std::string *errors) {
+    CompilationContext local(*parent);
+    std::ostringstream err;
+    local.cg = cg;
+    local.numErrors = 0;
+    local.err = &err;
+    CompilationContext *saved = ctx;
+    ctx = &local;
+    unit->Emit();
+    ctx = saved;
+    *numErrors = local.numErrors;
+    *errors = err.str();
+}
+
+void CodeGenerator::EmitUnits(List<Decl*> *units) {
+    int n = units->NumElements();
+    std::vector<CodeGenerator*> gens(n);
+    std::vector<int> errors(n);
+    std::vector<std::string> errorText(n);
+    std::vector<FnDecl*> fns(n);
+    UnitCache *cache = ctx->unitCache;
+    for (int i = 0; i < n; i++) {
+        fns[i] = dynamic_cast<FnDecl*>(units->Nth(i));
+        CodeGenerator *cached = (cache && fns[i]) ? cache->Lookup(fns[i])
+                                                  : NULL;
+        // a copy of the cached code shares its instructions, labels and
+        // temps, which are renamed again by Append.
+        gens[i] = cached ? new CodeGenerator(*cached) : new CodeGenerator();
+        errors[i] = 0;
+    }
+
+    CompilationContext *parent = ctx;
+    ParallelFor(n, ctx->numThreads, [&](int i) {
+        if (cache && fns[i] && cache->Lookup(fns[i])) return;
+        EmitUnit(parent, units->Nth(i), gens[i], &errors[i], &errorText[i]);
+    });
+
+    // the errors are reported in the order of the units.
+    int numErrors = 0;
+    for (int i = 0; i < n; i++) {
+        numErrors += errors[i];
+        *ctx->err << errorText[i];
+    }
+    for (int i = 0; i < n; i++) {
+        if (cache && fns[i] && numErrors == 0 && !cache->Lookup(fns[i]))
+            cache->Store(fns[i], new CodeGenerator(*gens[i]));
+        Append(gens[i]);
+        delete gens[i];
+    }
+    ctx->numErrors += numErrors;
+}
+
+void CodeGenerator::Append(CodeGenerator *other) {
+    for (int i = 0; i < other->labels->NumElements(); i++) {
+        char *label = other->labels->Nth(i);
+        snprintf(label, LabelSize, "_%sL%d", ctx->labelPrefix,
+                 labels->NumElements());
+        labels->Append(label);
+    }
+    for (int i = 0; i < other->temps->NumElements(); i++) {
+        char name[LabelSize];
+        Location *temp = other->temps->Nth(i);
+        sprintf(name, "_tmp%d", temps->NumElements());
+        temp->SetName(name);
+        temps->Append(temp);
+    }
+    code.splice(code.end(), other->code);
+}
+
 Location *CodeGenerator::GenLoadConstant(int value) {
     Location *result = GenTempVar();
     code.push_back(new LoadConstant(result, value));
     return result;
 }
 
-Location *CodeGenerator::GenLoadConstant(const char *s) {
+Location *CodeGenerator::GenLoadConstant(const char *s, int length) {
     Location *result = GenTempVar();
-    code.push_back(new LoadStringConstant(result, s));
+    code.push_back(new LoadStringConstant(result, s, length));
     return result;
 }
 
@@ -152,9 +252,10 @@ Location *CodeGenerator::GenLCall(const char *label, bool fnHasReturnValue) {
     return result;
 }
 
-Location *CodeGenerator::GenACall(Location *fnAddr, bool fnHasReturnValue) {
+Location *CodeGenerator::GenACall(Location *fnAddr, bool fnHasReturnValue,
+        const char *selector) {
     Location *result = fnHasReturnValue ? GenTempVar() : NULL;
-    code.push_back(new ACall(fnAddr, result));
+    code.push_back(new ACall(fnAddr, result, selector));
     return result;
 }
 
@@ -170,7 +271,8 @@ static struct _builtin {
     {"_PrintInt", 1, false},
     {"_PrintString", 1, false},
     {"_PrintBool", 1, false},
-    {"_Halt", 0, false}
+    {"_Halt", 0, false},
+    {"_DumpProfile", 1, false}
 };
 
 Location *CodeGenerator::GenBuiltInCall(BuiltIn bn,Location *arg1,
@@ -192,26 +294,408 @@ Location *CodeGenerator::GenBuiltInCall(BuiltIn bn,Location *arg1,
     return result;
 }
 
+const char *CodeGenerator::BuiltInLabel(BuiltIn b) {
+    Assert(b >= 0 && b < NumBuiltIns);
+    return builtins[b].label;
+}
+
 void CodeGenerator::GenVTable(const char *className,
+        List<const char *> *methodLabels, List<const char *> *itableLabels)
+{
+    code.push_back(new VTable(className, methodLabels, itableLabels));
+}
+
+void CodeGenerator::GenITable(const char *label,
         List<const char *> *methodLabels)
 {
-    code.push_back(new VTable(className, methodLabels));
+    code.push_back(new ITable(label, methodLabels));
+}
+
+typedef std::list<Instruction*>::iterator InstrIter;
+typedef std::set<const char*, ltstr> LabelSet;
+
+const char * const CodeGenerator::ProfileLabel = "__prof";
+
+/* Adds one to counter i of the profile table at base, before p.
+ */
+static void InsertCount(std::list<Instruction*> *code, InstrIter p,
+        Location *base, Location *count, Location *one, int i) {
+    int offset = 2 * CodeGenerator::VarSize + i * CodeGenerator::VarSize;
+    code->insert(p, new Load(count, base, offset));
+    code->insert(p, new BinaryOp(BinaryOp::Add, count, count, one));
+    code->insert(p, new Store(base, count, offset));
+}
+
+/* Prints the profile before p.
+ */
+static void InsertDump(std::list<Instruction*> *code, InstrIter p,
+        Location *temp) {
+    code->insert(p, new LoadLabel(temp, CodeGenerator::ProfileLabel));
+    code->insert(p, new PushParam(temp));
+    code->insert(p, new LCall(CodeGenerator::BuiltInLabel(DumpProfile), NULL));
+    code->insert(p, new PopParams(CodeGenerator::VarSize));
+}
+
+void CodeGenerator::Instrument(BeginFunc *begin, const char *function) {
+    std::string label = std::string(ProfileLabel) + "." + function;
+    ProfileTable *table = new ProfileTable(label.c_str(), function);
+    Location *base = GenTempVar(), *count = GenTempVar(),
+             *one = GenTempVar();
+    bool isMain = !strcmp(function, "main");
+
+    InstrIter p = std::find(code.begin(), code.end(), (Instruction*)begin);
+    Assert(p != code.end());
+    ++p;
+    code.insert(p, table);
+    code.insert(p, new LoadLabel(base, table->text()));
+    code.insert(p, new LoadConstant(one, 1));
+    int n = 0;
+    InsertCount(&code, p, base, count, one, n++);
+    while (p != code.end()) {
+        Instruction *i = *p++;
+        LCall *lc = dynamic_cast<LCall*>(i);
+        if (dynamic_cast<Label*>(i)) {
+            InsertCount(&code, p, base, count, one, n++);
+        } else if (dynamic_cast<IfZ*>(i)) {
+            // the block after a branch, unless it starts at a label.
+            if (p != code.end() && !dynamic_cast<Label*>(*p))
+                InsertCount(&code, p, base, count, one, n++);
+        } else if (lc && !strcmp(lc->callee(), BuiltInLabel(Halt))) {
+            InsertDump(&code, --p, count);
+            ++p;
+        } else if (isMain && dynamic_cast<Return*>(i)) {
+            InsertDump(&code, --p, count);
+            ++p;
+        }
+    }
+    if (isMain) InsertDump(&code, code.end(), count);
+    table->SetNumCounters(n);
+}
+
+/* A basic block of a function, for LayoutBlocks.
+ */
+struct Block {
+    typedef enum { Fall, Jump, Branch, Stop } End;
+
+    std::vector<Instruction*> code;
+    const char *label;      // the label it starts at, or NULL.
+    long count;             // the runs in the profile.
+    End end;                // Stop: a Return or a Halt.
+    int fall, taken;        // the blocks which may follow, or -1.
+    Instruction *last;      // the Goto or the IfZ it ends with.
+
+    Block() : label(NULL), count(0), end(Fall), fall(-1), taken(-1),
+              last(NULL) {}
+};
+
+void CodeGenerator::LayoutBlocks(BeginFunc *begin, const char *function) {
+    InstrIter first = std::find(code.begin(), code.end(),
+                                (Instruction*)begin);
+    Assert(first != code.end());
+    ++first;
+
+    // the blocks, numbered as the counters of Instrument.
+    std::vector<Block> blocks(1);
+    for (InstrIter p = first; p != code.end(); ++p) {
+        if (Label *l = dynamic_cast<Label*>(*p)) {
+            blocks.push_back(Block());
+            blocks.back().label = l->text();
+        }
+        blocks.back().code.push_back(*p);
+        InstrIter next = p;
+        ++next;
+        if (dynamic_cast<IfZ*>(*p) && next != code.end() &&
+            !dynamic_cast<Label*>(*next))
+            blocks.push_back(Block());
+    }
+    int n = blocks.size(), exit = n;
+    const std::vector<long> *counts = ctx->profile->CountsOf(function);
+    if (!counts || (int)counts->size() != n || (*counts)[0] == 0) return;
+
+    std::map<const char*, int, ltstr> at;
+    for (int b = 0; b < n; b++)
+        if (blocks[b].label) at[blocks[b].label] = b;
+    for (int b = 0; b < n; b++) {
+        Block &k = blocks[b];
+        k.count = (*counts)[b];
+        k.fall = b + 1;
+        for (size_t j = 0; j < k.code.size(); j++) {
+            Instruction *i = k.code[j];
+            Goto *g = dynamic_cast<Goto*>(i);
+            IfZ *z = dynamic_cast<IfZ*>(i);
+            LCall *lc = dynamic_cast<LCall*>(i);
+            if (g || z) {
+                const char *target = g ? g->branch_label() :
+                                         z->branch_label();
+                if (!at.count(target)) return;  // not a label of ours.
+                k.end = g ? Block::Jump : Block::Branch;
+                k.taken = at[target];
+                k.last = i;
+                if (g) k.fall = -1;
+                break;
+            }
+            if (dynamic_cast<Return*>(i) ||
+                (lc && !strcmp(lc->callee(), BuiltInLabel(Halt)))) {
+                k.end = Block::Stop;
+                k.fall = -1;
+                break;
+            }
+        }
+    }
+
+    // chain the blocks from the entry, each followed by its likeliest
+    // successor not yet placed, or else by the next block run in the
+    // order of the code: the blocks never run go to the end.
+    std::vector<bool> placed(n + 1, false), negate(n, false);
+    std::vector<int> order;
+    placed[exit] = true;
+    for (int b = 0; b >= 0; ) {
+        placed[b] = true;
+        order.push_back(b);
+        Block &k = blocks[b];
+        int next = -1;
+        if (k.end == Block::Fall && !placed[k.fall]) {
+            next = k.fall;
+        } else if (k.end == Block::Jump && !placed[k.taken]) {
+            next = k.taken;
+        } else if (k.end == Block::Branch) {
+            if (!placed[k.taken] && (placed[k.fall] ||
+                blocks[k.taken].count > blocks[k.fall].count)) {
+                next = k.taken;
+                negate[b] = true;
+            } else if (!placed[k.fall]) {
+                next = k.fall;
+            }
+        }
+        for (int c = 1; next < 0 && c < n; c++)
+            if (!placed[c] && blocks[c].count > 0) next = c;
+        for (int c = 1; next < 0 && c < n; c++)
+            if (!placed[c]) next = c;
+        b = next;
+    }
+
+    // the branches and gotos for the new order, with new labels where
+    // they are needed. The end of the function is reached by a Return.
+    const char *exitLabel = NULL;
+    auto labelOf = [&](int b) -> const char* {
+        if (b == exit) return exitLabel ? exitLabel : exitLabel = NewLabel();
+        Block &k = blocks[b];
+        if (!k.label) {
+            k.label = NewLabel();
+            k.code.insert(k.code.begin(), new Label(k.label));
+        }
+        return k.label;
+    };
+    for (size_t o = 0; o < order.size(); o++) {
+        int b = order[o], next = o + 1 < order.size() ? order[o + 1] : exit;
+        Block &k = blocks[b];
+        int fall = k.fall;
+        if (negate[b]) {
+            // an IfZ ends its block.
+            IfZ *z = dynamic_cast<IfZ*>(k.last);
+            k.code.back() = new IfZ(z->test_var(), labelOf(k.fall),
+                                    !z->if_nonzero());
+            fall = k.taken;
+        }
+        if (k.end == Block::Jump && k.code.back() == k.last &&
+            k.taken == next)
+            k.code.pop_back();
+        else if (fall == exit && next != exit)
+            k.code.push_back(new Return(NULL));
+        else if (fall >= 0 && fall != next)
+            k.code.push_back(new Goto(labelOf(fall)));
+    }
+
+    code.erase(first, code.end());
+    for (size_t o = 0; o < order.size(); o++) {
+        Block &k = blocks[order[o]];
+        code.insert(code.end(), k.code.begin(), k.code.end());
+    }
+    if (exitLabel) code.push_back(new Label(exitLabel));
+}
+
+/* The method labels are _Class.method, the selector is the method name.
+ */
+static const char *SelectorOf(const char *methodLabel) {
+    const char *s = strchr(methodLabel, '.');
+    return s ? s + 1 : methodLabel;
+}
+
+/* The state of the rapid type analysis.
+ */
+struct Reachability {
+    LabelSet functions;     // reachable functions and methods.
+    LabelSet classes;       // instantiated classes.
+    LabelSet selectors;     // names of the methods called by ACall.
+    bool any_selector;      // an ACall without a known name.
+    std::list<const char*> worklist;
+
+    Reachability() : any_selector(false) {}
+    void AddFunction(const char *label) {
+        if (functions.insert(label).second) worklist.push_back(label);
+    }
+    void AddMethods(VTable *vt, const char *selector) {
+        List<const char*> *m = vt->methods();
+        for (int i = 0; i < m->NumElements(); i++) {
+            if (!selector || !strcmp(SelectorOf(m->Nth(i)), selector))
+                AddFunction(m->Nth(i));
+        }
+    }
+    void AddCalledMethods(VTable *vt) {
+        List<const char*> *m = vt->methods();
+        for (int i = 0; i < m->NumElements(); i++) {
+            if (any_selector || selectors.count(SelectorOf(m->Nth(i))))
+                AddFunction(m->Nth(i));
+        }
+    }
+};
+
+/* Replace the labels of the unreachable methods by 0.
+ */
+static void ClearSlots(List<const char*> *labels, LabelSet *reached) {
+    for (int i = 0; i < labels->NumElements(); i++) {
+        if (!reached->count(labels->Nth(i))) {
+            labels->RemoveAt(i);
+            labels->InsertAt("0", i);
+        }
+    }
+}
+
+void CodeGenerator::RemoveUnreachableCode() {
+    // index the functions (a label followed by BeginFunc) and the vtables.
+    std::map<const char*, InstrIter, ltstr> funcs;
+    std::map<const char*, VTable*, ltstr> vtables;
+    for (InstrIter p = code.begin(); p != code.end(); ++p) {
+        InstrIter q = p; ++q;
+        Label *l = dynamic_cast<Label*>(*p);
+        VTable *vt = dynamic_cast<VTable*>(*p);
+        if (l && q != code.end() && dynamic_cast<BeginFunc*>(*q)) {
+            funcs[l->text()] = p;
+        } else if (vt) {
+            vtables[vt->text()] = vt;
+        }
+    }
+
+    // walk the reachable functions from main.
+    Reachability r;
+    r.AddFunction("main");
+    // the code of the libraries may call any method of our objects.
+    r.any_selector = ctx->imports->NumElements() > 0;
+    while (!r.worklist.empty()) {
+        const char *fn = r.worklist.front();
+        r.worklist.pop_front();
+        if (!funcs.count(fn)) continue; // built-in functions in defs.asm.
+
+        for (InstrIter p = funcs[fn]; p != code.end(); ++p) {
+            if (dynamic_cast<EndFunc*>(*p)) break;
+            LCall *lc = dynamic_cast<LCall*>(*p);
+            ACall *ac = dynamic_cast<ACall*>(*p);
+            LoadLabel *ll = dynamic_cast<LoadLabel*>(*p);
+            if (lc) {
+                r.AddFunction(lc->callee());
+            } else if (ll && vtables.count(ll->text())) {
+                // a new instance of a class, add its called methods.
+                if (r.classes.insert(ll->text()).second)
+                    r.AddCalledMethods(vtables[ll->text()]);
+            } else if (ac) {
+                // a new selector, add the methods of the classes so far.
+                const char *s = ac->method_name();
+                if (s ? !r.selectors.insert(s).second : r.any_selector)
+                    continue;
+                if (!s) r.any_selector = true;
+                LabelSet::iterator c;
+                for (c = r.classes.begin(); c != r.classes.end(); ++c) {
+                    r.AddMethods(vtables[*c], s);
+                }
+            }
+        }
+    }
+
+    // the interface tables of the classes never instantiated.
+    LabelSet dead_itables;
+    std::map<const char*, VTable*, ltstr>::iterator v;
+    for (v = vtables.begin(); v != vtables.end(); ++v) {
+        List<const char*> *itables = v->second->itables();
+        if (r.classes.count(v->first) || !itables) continue;
+        for (int i = 0; i < itables->NumElements(); i++) {
+            if (itables->Nth(i)) dead_itables.insert(itables->Nth(i));
+        }
+    }
+
+    // remove the unreachable code and data.
+    InstrIter p = code.begin();
+    while (p != code.end()) {
+        Label *l = dynamic_cast<Label*>(*p);
+        VTable *vt = dynamic_cast<VTable*>(*p);
+        ITable *it = dynamic_cast<ITable*>(*p);
+        if (l && funcs.count(l->text()) && !r.functions.count(l->text())) {
+            Trace(T_Dce, "Remove function %s.", l->text());
+            while (!dynamic_cast<EndFunc*>(*p)) p = code.erase(p);
+            p = code.erase(p);
+        } else if (vt && !r.classes.count(vt->text())) {
+            Trace(T_Dce, "Remove vtable %s.", vt->text());
+            p = code.erase(p);
+        } else if (it && dead_itables.count(it->text())) {
+            Trace(T_Dce, "Remove interface table %s.", it->text());
+            p = code.erase(p);
+        } else {
+            if (vt) ClearSlots(vt->methods(), &r.functions);
+            if (it) ClearSlots(it->methods(), &r.functions);
+            ++p;
+        }
+    }
 }
 
 void CodeGenerator::DoFinalCodeGen() {
-    if (IsDebugOn("tac")) { // if debug don't translate to mips, just print Tac
+    // all the code of a library is kept, see summary.h.
+    Stats::Start("unreachable");
+    if (!ctx->summaryFile) RemoveUnreachableCode();
+
+    // the table of the profile tables left, see Instrument.
+    if (ctx->instrument) {
+        List<const char*> *tables = new List<const char*>;
+        for (InstrIter p = code.begin(); p != code.end(); ++p) {
+            ProfileTable *t = dynamic_cast<ProfileTable*>(*p);
+            if (t) tables->Append(t->text());
+        }
+        tables->Append("0");
+        GenVTable(ProfileLabel, tables);
+    }
+    Stats::Count(Stats::TacInstructions, code.size());
+
+    if (ctx->run || ctx->bytecodeFile) {
+        // a program with errors is not run.
+        if (ctx->numErrors > 0) return;
+        Stats::Start("bytecode");
+        Interpreter interp(ctx->out, ctx->err);
+        std::list<Instruction*>::iterator p;
+        for (p = code.begin(); p != code.end(); ++p) {
+            (*p)->EmitSpecific(&interp);
+        }
+        if (!interp.Finish()) return;
+        if (ctx->bytecodeFile && !interp.Write(ctx->bytecodeFile)) {
+            ReportError::Formatted(NULL, "Cannot write bytecode file %s.",
+                    ctx->bytecodeFile);
+        } else if (ctx->run) {
+            Stats::Start("run");
+            ctx->runStatus = interp.Run();
+        }
+    } else if (IsDebugOn("tac")) { // if debug don't translate to mips, just print Tac
         std::list<Instruction*>::iterator p;
         for (p= code.begin(); p != code.end(); ++p) {
             (*p)->Print();
         }
     }  else {
-        Mips mips;
-        mips.EmitPreamble();
+        Stats::Start(ctx->targetName);
+        Target *target = Target::New(ctx->targetName);
+        target->EmitPreamble();
 
         std::list<Instruction*>::iterator p;
         for (p= code.begin(); p != code.end(); ++p) {
-            (*p)->Emit(&mips);
+            (*p)->Emit(target);
         }
+        target->EmitEpilogue();
+        delete target;
     }
 }
 
@@ -18,13 +18,18 @@
 #include <list>
 #include "tac.h"
 
+class Decl;
+
 // These codes are used to identify the built-in functions
 typedef enum { Alloc, ReadLine, ReadInteger, StringEqual,
-               PrintInt, PrintString, PrintBool, Halt, NumBuiltIns } BuiltIn;
+               PrintInt, PrintString, PrintBool, Halt, DumpProfile,
+               NumBuiltIns } BuiltIn;
 
 class CodeGenerator {
   private:
     std::list<Instruction*> code;
+    List<char*> *labels;            // made by NewLabel, in order.
+    List<Location*> *temps;         // made by GenTempVar, in order.
     int local_loc;
     int param_loc;
     int globl_loc;
@@ -49,6 +54,8 @@ class CodeGenerator {
     int GetNextLocalLoc();
     int GetNextParamLoc();
     int GetNextGlobalLoc();
+    // the globals of the libraries are below end, see summary.h.
+    void ReserveGlobals(int end);
     int GetFrameSize();
     void ResetFrameSize();
 
@@ -58,23 +65,39 @@ class CodeGenerator {
 
     // Assigns a new unique label name and returns it. Does not
     // generate any Tac instructions (see GenLabel below if needed)
+    // The labels and temps are numbered in this code generator only,
+    // they are renamed when the code is appended to another one.
     char *NewLabel();
 
     // Creates and returns a Location for a new uniquely named
     // temp variable. Does not generate any Tac instructions
     Location *GenTempVar();
 
+    // Emits the units of the program, in parallel on the threads of
+    // the compilation. Each unit is emitted into a code generator of its
+    // own, in a context of its own which shares everything else, then the
+    // code of the units is appended in order, so the result is the same
+    // as emitting them one after the other. The functions found in the
+    // unit cache of the compile server are not emitted again, see
+    // unitcache.h.
+    void EmitUnits(List<Decl*> *units);
+
+    // Moves the code of other to the end of this code. The labels and
+    // temps of other are renumbered after ours.
+    void Append(CodeGenerator *other);
+
     // Generates Tac instructions to load a constant value. Creates
     // a new temp var to hold the result. The constant
     // value is passed as an integer, it can be 0 for integer zero,
     // false for bool, NULL for null object, etc. All are just 4-byte
     // zero in the code generation world.
-    // The second overloaded version is used for string constants.
+    // The second overloaded version is used for string constants, the
+    // length is only needed if str is not null terminated.
     // The LoadLabel method loads a label into a temporary.
     // Each of the methods returns a Location for the temp var
     // where the constant was loaded.
     Location *GenLoadConstant(int value);
-    Location *GenLoadConstant(const char *str);
+    Location *GenLoadConstant(const char *str, int length = -1);
     Location *GenLoadLabel(const char *label);
 
     // Generates Tac instructions to copy value from one location to another
@@ -126,7 +149,10 @@ class CodeGenerator {
     // described above, in terms of return type.
     // The fnAddr Location is expected to hold the address of
     // the code to jump to (typically it was read from the vtable)
-    Location *GenACall(Location *fnAddr, bool fnHasReturnValue);
+    // The optional selector is the name of the called method, it is used
+    // to find the reachable methods, see RemoveUnreachableCode below.
+    Location *GenACall(Location *fnAddr, bool fnHasReturnValue,
+            const char *selector = NULL);
 
     // Generates the Tac instructions to call one of
     // the built-in functions (Read, Print, Alloc, etc.) Although
@@ -140,6 +166,9 @@ class CodeGenerator {
     Location *GenBuiltInCall(BuiltIn b, Location *arg1 = NULL,
             Location *arg2 = NULL);
 
+    // The label of a built-in function in defs.asm.
+    static const char *BuiltInLabel(BuiltIn b);
+
     // These methods generate the Tac instructions for various
     // control flow (branches, jumps, returns, labels)
     // One minor detail to mention is that you can pass NULL
@@ -160,7 +189,46 @@ class CodeGenerator {
     // methods in the order they should be laid out.  The vtable
     // is tagged with a label of the class name, so when you later
     // need access to the vtable, you use LoadLabel of class name.
-    void GenVTable(const char *className, List<const char*> *methodLabels);
+    // If the program has interfaces, the itableLabels parameter lists
+    // the interface tables of the class by interface number (NULL for
+    // an interface not implemented), they are laid out just below the
+    // vtable label, the table of interface n at offset -4 * (n + 1).
+    void GenVTable(const char *className, List<const char*> *methodLabels,
+                   List<const char*> *itableLabels = NULL);
+
+    // Generates the table of a class for one interface, with the methods
+    // in the order they are declared in the interface.
+    void GenITable(const char *label, List<const char*> *methodLabels);
+
+    // Adds the profile counters to the function just emitted, whose
+    // BeginFunc is given, for --instrument. The counters are in a table
+    // of the function, ProfileLabel.<function>, made by a ProfileTable
+    // instruction: counter 0 counts the calls, and the next ones the runs
+    // of the basic blocks, in the order of the code, each block starting
+    // at a label or after an IfZ. The profile is printed by the built-in
+    // DumpProfile, called before Halt and when main returns, after the
+    // output of the program: a newline, the line "# profile", then the
+    // lines "<function> <counter> <count>".
+    void Instrument(BeginFunc *begin, const char *function);
+
+    // Lays out the basic blocks of the function just emitted with the
+    // counts of ctx->profile, for --profile-use: from the entry, each
+    // block is followed by its most frequent successor, an IfZ being
+    // turned into an IfNZ when its target is the hotter one, and the
+    // blocks never run, such as the paths to Halt of the runtime checks,
+    // go to the end of the function. Nothing is done if the function is
+    // not in the profile or its blocks do not match the counters.
+    void LayoutBlocks(BeginFunc *begin, const char *function);
+
+    // the label of the table of all the profile tables.
+    static const char * const ProfileLabel;
+
+    // Removes the functions and methods which cannot be reached from
+    // main, by a rapid type analysis on the Tac: a method is reachable
+    // only if its class is instantiated and a reachable ACall uses its
+    // name. The vtables of the classes never instantiated are removed,
+    // and the slots of unreachable methods are set to 0.
+    void RemoveUnreachableCode();
 
     // Emits the final "object code" for the program by
     // translating the sequence of Tac instructions into their mips
@@ -168,6 +236,8 @@ class CodeGenerator {
     // flag tac is on (-d tac), it will not translate to MIPS,
     // but instead just print the untranslated Tac. It may be
     // useful in debugging to first make sure your Tac is correct.
+    // With --run or --emit-bytecode, the Tac is lowered to bytecode
+    // instead, which is run or written, see interp.h.
     void DoFinalCodeGen();
 };
 
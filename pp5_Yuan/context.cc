@@ -0,0 +1,76 @@
+/* File: context.cc
+ * ----------------
+ * Implementation of CompilationContext.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "context.h"
+#include "codegen.h"
+#include "parser.h"
+#include "errors.h"
+#include "stats.h"
+#include "trace.h"
+
+thread_local CompilationContext *ctx = NULL;
+
+CompilationContext::CompilationContext() {
+    inputFile = NULL;
+    input = NULL;
+    inputSize = 0;
+    inputMapped = false;
+    lineStarts = NULL;
+    scanner = NULL;
+    curLineNum = curColNum = 1;
+    symtab = NULL;
+    typetab = NULL;
+    checkTasks = NULL;
+    for (int c = E_BuildST; c <= E_CheckType; c++) passErr[c] = NULL;
+    numErrors = 0;
+    cg = new CodeGenerator();
+    nextStrNum = 1;
+    labelPrefix = "";
+    numThreads = 1;
+    targetName = "mips";
+    instrument = false;
+    profile = NULL;
+    unitCache = NULL;
+    run = false;
+    bytecodeFile = NULL;
+    runStatus = 0;
+    summaryFile = NULL;
+    imports = new List<const char*>;
+    cacheDir = NULL;
+    cacheSize = 256L << 20;
+    stats = NULL;
+    reportFile = NULL;
+    debugKeys = new List<const char*>;
+    traceMask = 0;
+    trace = NULL;
+    out = stdout;
+    err = &std::cerr;
+}
+
+int CompilationContext::Compile() {
+    CompilationContext *saved = ctx;
+    ctx = this;
+
+    int result = -1;
+    TraceBuffer::Enable(this);
+    Stats::Start("input");
+    if (InitScanner()) {
+        InitParser();
+        Stats::Start("parse");
+        yyparse(scanner);
+        EndParser();
+        DestroyScanner();
+        if (stats && !stats->Report(*err, reportFile))
+            ReportError::Formatted(NULL, "Cannot write report file %s.",
+                    reportFile);
+        result = numErrors;
+    }
+    if (trace) trace->Dump(out);
+
+    ctx = saved;
+    return result;
+}
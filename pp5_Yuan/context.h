@@ -0,0 +1,93 @@
+/* File: context.h
+ * ---------------
+ * A CompilationContext holds all the state of one compilation: the input
+ * and the reentrant scanner, the symbol and type tables, the code
+ * generator and the counter for string constants, the debug keys, the
+ * error count and the output streams. Nothing is kept in
+ * process-wide globals, so several compilations can run in one process at
+ * once, each on its own thread.
+ *
+ * The context of the compilation running on the current thread is ctx,
+ * so the AST nodes can reach it without passing it around.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_context
+#define _H_context
+
+#include <stdio.h>
+#include <iostream>
+#include "list.h"
+
+class SymbolTable;
+class TypeTable;
+class CodeGenerator;
+class CheckTasks;
+class UnitCache;
+class Profile;
+class Stats;
+class TraceBuffer;
+
+class CompilationContext
+{
+  public:
+    // input.
+    const char *inputFile;          // NULL for stdin.
+    char *input;                    // the whole input, see InitScanner,
+                                    // or given by the caller.
+    size_t inputSize;
+    bool inputMapped;               // input is a mapping of inputFile.
+    List<int> *lineStarts;          // built on the first error.
+    // scanner.
+    void *scanner;                  // the yyscan_t of the scanner.
+    int curLineNum, curColNum;
+    // semantic check.
+    SymbolTable *symtab;
+    TypeTable *typetab;
+    CheckTasks *checkTasks;         // set while the passes defer bodies.
+    std::ostream *passErr[E_CheckType + 1]; // in the walk of a body.
+    int numErrors;
+    // code generation.
+    CodeGenerator *cg;
+    int nextStrNum;
+    const char *labelPrefix;        // of the labels of a library.
+    int numThreads;                 // for the parallel check and emission.
+    const char *targetName;         // --target, see target.h.
+    bool instrument;                // --instrument, see
+                                    // CodeGenerator::Instrument.
+    Profile *profile;               // --profile-use, or NULL, see
+                                    // CodeGenerator::LayoutBlocks.
+    UnitCache *unitCache;           // kept by the compile server, or NULL.
+    // --run and --emit-bytecode, see interp.h.
+    bool run;
+    const char *bytecodeFile;       // or NULL.
+    int runStatus;                  // the exit status of the program.
+    // separate compilation, see summary.h.
+    const char *summaryFile;        // --emit-summary, or NULL.
+    List<const char*> *imports;     // the summaries, in order.
+    // the compilation cache, see diskcache.h.
+    const char *cacheDir;           // NULL if not cached.
+    long cacheSize;                 // the bound of the cache, in bytes.
+    // --time-report and --stats, see stats.h.
+    Stats *stats;                   // NULL if there is no report.
+    const char *reportFile;         // --report-json, or NULL.
+    // debug keys and output.
+    List<const char*> *debugKeys;
+    unsigned traceMask;             // the trace categories on, and their
+    TraceBuffer *trace;             // records, see trace.h.
+    FILE *out;                      // assembly, tac and debug output.
+    std::ostream *err;              // error messages.
+
+  public:
+    // constructor.
+    CompilationContext();
+    // scan, parse, check and emit the input, returns the number of
+    // errors, or -1 if the input cannot be read.
+    int Compile();
+};
+
+// the context of the compilation running on the current thread.
+extern thread_local CompilationContext *ctx;
+
+#endif
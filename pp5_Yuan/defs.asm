@@ -169,8 +169,61 @@ eloop4: addi    $t1, -1         # add '\0' at the end.
         jr      $ra
 
 
+_DumpProfile:
+        subu    $sp, $sp, 8     # decrement sp to make space to save ra, fp
+        sw      $fp, 8($sp)     # save fp
+        sw      $ra, 4($sp)     # save ra
+        addiu   $fp, $sp, 8     # set up new fp
+
+        li      $v0, 4
+        la      $a0, PROFILE
+        syscall
+        lw      $t0, 4($fp)     # the table of the profile tables
+
+prof1:  lw      $t1, ($t0)      # a profile table: name, size, counters
+        beqz    $t1, prof3
+        lw      $t2, 4($t1)
+        li      $t3, 0
+
+prof2:  sub     $t4, $t2, $t3   # print "name index count" for each counter
+        blez    $t4, eprof2
+        li      $v0, 4
+        lw      $a0, ($t1)
+        syscall
+        li      $v0, 4
+        la      $a0, BLANK
+        syscall
+        li      $v0, 1
+        move    $a0, $t3
+        syscall
+        li      $v0, 4
+        la      $a0, BLANK
+        syscall
+        mul     $t4, $t3, 4
+        add     $t4, $t4, $t1
+        li      $v0, 1
+        lw      $a0, 8($t4)
+        syscall
+        li      $v0, 4
+        la      $a0, NEWLINE
+        syscall
+        addi    $t3, 1
+        b       prof2
+
+eprof2: addi    $t0, 4
+        b       prof1
+
+prof3:  move    $sp, $fp        # pop callee frame off stack
+        lw      $ra, -4($fp)    # restore saved ra
+        lw      $fp, 0($fp)     # restore saved fp
+        jr      $ra
+
+
 .data
 TRUE:.asciiz "true"
 FALSE:.asciiz "false"
+PROFILE:.asciiz "\n# profile\n"
+BLANK:.asciiz " "
+NEWLINE:.asciiz "\n"
 SPACE:.asciiz "Making Space For Inputed Values Is Fun."
 
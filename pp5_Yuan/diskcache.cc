@@ -0,0 +1,206 @@
+/* File: diskcache.cc
+ * ------------------
+ * Implementation of DiskCache.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "diskcache.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include "context.h"
+#include "scanner.h"
+
+// bump when the output of the compiler changes.
+static const char *CompilerVersion = "dcc 1.0";
+
+static const char *EntrySuffix = ".dcc";
+
+DiskCache::DiskCache(const char *d, long size) : dir(d) {
+    maxSize = size;
+}
+
+/*
+ * FNV-1a with 128 bits, the key is folded over its pieces.
+ */
+typedef unsigned __int128 uint128;
+
+static uint128 Hash(uint128 h, const void *data, size_t n) {
+    const uint128 prime = ((uint128)1 << 88) | 0x13B;
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= prime;
+    }
+    return h;
+}
+
+std::string DiskCache::KeyFor(CompilationContext *c) {
+    uint128 h = ((uint128)0x6c62272e07bb0142ULL << 64) |
+                0x62b821756295c58dULL;
+    h = Hash(h, CompilerVersion, strlen(CompilerVersion) + 1);
+    struct stat st;
+    if (stat("/proc/self/exe", &st) == 0) {
+        long exe[2] = { (long)st.st_size, (long)st.st_mtime };
+        h = Hash(h, exe, sizeof(exe));
+    }
+    // the options which change the output: the target and the profile,
+    // -j does not and the debug keys, --run, the bytecode, the separate
+    // compilation, --profile-use and the reports turn the cache off.
+    std::string flags = c->targetName;
+    if (c->instrument) flags += " --instrument";
+    h = Hash(h, flags.c_str(), flags.size() + 1);
+    h = Hash(h, c->input, c->inputSize);
+
+    char key[40];
+    snprintf(key, sizeof(key), "%016llx%016llx",
+             (unsigned long long)(h >> 64), (unsigned long long)h);
+    return key;
+}
+
+/*
+ * An entry is a line "dcc-cache <errors> <asm-size> <err-size>" followed
+ * by the assembly and the error messages. Returns false if there is no
+ * valid entry.
+ */
+bool DiskCache::Replay(const std::string &path, CompilationContext *c,
+                       int *numErrors) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    char *p = (char *)MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        p = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+
+    // the mapping has no terminating null, the header line is parsed from
+    // a copy.
+    char line[128];
+    size_t outSize, errSize;
+    int header = 0;
+    const char *end = (const char *)memchr(p, '\n', st.st_size);
+    bool ok = end && end - p < (long)sizeof(line);
+    if (ok) {
+        memcpy(line, p, end - p);
+        line[end - p] = '\0';
+        ok = sscanf(line, "dcc-cache %d %zu %zu%n", numErrors, &outSize,
+                    &errSize, &header) == 3 &&
+             p + header++ == end &&
+             header + outSize + errSize == (size_t)st.st_size;
+    }
+    if (ok) {
+        fwrite(p + header, 1, outSize, c->out);
+        c->err->write(p + header + outSize, errSize);
+        // the entry is used, see Evict.
+        utimensat(AT_FDCWD, path.c_str(), NULL, 0);
+    }
+    munmap(p, st.st_size);
+    return ok;
+}
+
+void DiskCache::Store(const std::string &path, int numErrors,
+                      const std::string &out, const std::string &err) {
+    char tmp[64];
+    snprintf(tmp, sizeof(tmp), "/tmp.%d.%lx", (int)getpid(), random());
+    std::string tmpPath = dir + tmp;
+    FILE *fp = fopen(tmpPath.c_str(), "w");
+    if (!fp) return;
+    fprintf(fp, "dcc-cache %d %zu %zu\n", numErrors, out.size(), err.size());
+    fwrite(out.data(), 1, out.size(), fp);
+    fwrite(err.data(), 1, err.size(), fp);
+    // a reader sees the whole entry or none.
+    if (fclose(fp) != 0 || rename(tmpPath.c_str(), path.c_str()) != 0)
+        unlink(tmpPath.c_str());
+}
+
+/*
+ * Remove the least recently used entries until the cache fits.
+ */
+void DiskCache::Evict() {
+    DIR *d = opendir(dir.c_str());
+    if (!d) return;
+    struct Entry {
+        std::string path;
+        time_t used;
+        long size;
+        bool operator<(const Entry &e) const { return used < e.used; }
+    };
+    std::vector<Entry> entries;
+    long total = 0;
+    size_t suffix = strlen(EntrySuffix);
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL) {
+        size_t len = strlen(de->d_name);
+        if (len <= suffix || strcmp(de->d_name + len - suffix, EntrySuffix))
+            continue;
+        Entry e;
+        e.path = dir + "/" + de->d_name;
+        struct stat st;
+        if (stat(e.path.c_str(), &st) != 0) continue;
+        e.used = st.st_mtime;
+        e.size = st.st_size;
+        total += e.size;
+        entries.push_back(e);
+    }
+    closedir(d);
+
+    if (total <= maxSize) return;
+    std::sort(entries.begin(), entries.end());
+    for (size_t i = 0; i < entries.size() && total > maxSize; i++) {
+        if (unlink(entries[i].path.c_str()) == 0) total -= entries[i].size;
+    }
+}
+
+int DiskCache::Compile(CompilationContext *c) {
+    CompilationContext *saved = ctx;
+    ctx = c;
+    bool loaded = LoadInput();
+    ctx = saved;
+    if (!loaded) return -1;
+    if (c->debugKeys->NumElements() > 0 || c->run || c->bytecodeFile ||
+        c->summaryFile || c->imports->NumElements() > 0 || c->profile ||
+        c->stats)
+        return c->Compile();
+
+    mkdir(dir.c_str(), 0777);
+    std::string path = dir + "/" + KeyFor(c) + EntrySuffix;
+    int numErrors;
+    if (Replay(path, c, &numErrors)) return numErrors;
+
+    // compile in memory, then print and keep the result.
+    FILE *out = c->out;
+    std::ostream *err = c->err;
+    char *text = NULL;
+    size_t len = 0;
+    c->out = open_memstream(&text, &len);
+    if (!c->out) {
+        c->out = out;
+        return c->Compile();
+    }
+    std::ostringstream errStream;
+    c->err = &errStream;
+    numErrors = c->Compile();
+    fclose(c->out);
+    c->out = out;
+    c->err = err;
+
+    std::string asmText(text, len), errText = errStream.str();
+    free(text);
+    fwrite(asmText.data(), 1, asmText.size(), out);
+    *err << errText;
+    if (numErrors >= 0) {
+        Store(path, numErrors, asmText, errText);
+        Evict();
+    }
+    return numErrors;
+}
@@ -0,0 +1,55 @@
+/* File: diskcache.h
+ * -----------------
+ * The DiskCache keeps the results of compilations in a directory, so an
+ * unchanged program is not compiled again:
+ *
+ *    dcc [<file>] --cache-dir <dir> [--cache-size <megabytes>]
+ *
+ * A result is found by a 128-bit hash of the input, the version of the
+ * compiler (with the size and time of the dcc executable, so a rebuilt
+ * compiler misses) and the options which change the output. It holds
+ * the assembly, the error messages and the number of errors, and is
+ * replayed on a hit: the entry is mapped and written to the output and
+ * error streams as they are.
+ *
+ * An entry is written to a temporary file and renamed into place, so
+ * several compilations may share the directory. A hit touches the time of
+ * its entry, and after a miss the least recently used entries are removed
+ * until the directory fits in the cache size (256 MB by default). The
+ * cache is off with debug keys, whose output is not all captured, with
+ * --run and --emit-bytecode, and for the separate compilation and
+ * --profile-use, which read and write other files, and with
+ * --time-report and --stats, which report on the compilation itself.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_diskcache
+#define _H_diskcache
+
+#include <string>
+
+class CompilationContext;
+
+class DiskCache
+{
+  protected:
+    std::string dir;
+    long maxSize;
+
+    std::string KeyFor(CompilationContext *c);
+    bool Replay(const std::string &path, CompilationContext *c,
+                int *numErrors);
+    void Store(const std::string &path, int numErrors,
+               const std::string &out, const std::string &err);
+    void Evict();
+
+  public:
+    // constructor.
+    DiskCache(const char *dir, long maxSize);
+    // compiles the input of the context through the cache, returns the
+    // number of errors, or -1 if the input cannot be read, as Compile.
+    int Compile(CompilationContext *c);
+};
+
+#endif
@@ -15,26 +15,32 @@ using namespace std;
 #include "ast_expr.h"
 #include "ast_stmt.h"
 #include "ast_decl.h"
+#include "context.h"
 
-int ReportError::numErrors = 0;
+int ReportError::NumErrors() {
+    return ctx->numErrors;
+}
 
 void ReportError::UnderlineErrorInLine(const char *line, yyltype *pos) {
     if (!line) return;
-    cerr << line << endl;
+    ostream &err = *ctx->err;
+    err << line << endl;
     for (int i = 1; i <= pos->last_column; i++)
-        cerr << (i >= pos->first_column ? '^' : ' ');
-    cerr << endl;
+        err << (i >= pos->first_column ? '^' : ' ');
+    err << endl;
+    delete[] line; // a copy, see GetLineNumbered.
 }
 
 void ReportError::OutputError(yyltype *loc, string msg) {
-    numErrors++;
-    fflush(stdout); // make sure any buffered text has been output
+    ostream &err = *ctx->err;
+    ctx->numErrors++;
+    fflush(ctx->out); // make sure any buffered text has been output
     if (loc) {
-        cerr << endl << "*** Error line " << loc->first_line << "." << endl;
+        err << endl << "*** Error line " << loc->first_line << "." << endl;
         UnderlineErrorInLine(GetLineNumbered(loc->first_line), loc);
     } else
-        cerr << endl << "*** Error." << endl;
-    cerr << "*** " << msg << endl << endl;
+        err << endl << "*** Error." << endl;
+    err << "*** " << msg << endl << endl;
 }
 
 void ReportError::Formatted(yyltype *loc, const char *format, ...) {
@@ -195,12 +201,13 @@ void ReportError::NoMainFound() {
  * -------------------
  * Standard error-reporting function expected by yacc. Our version merely
  * just calls into the error reporter above, passing the location of
- * the last token read. If you want to suppress the ordinary "parse error"
+ * the last token read, which the pure parser hands to us with its
+ * scanner. If you want to suppress the ordinary "parse error"
  * message from yacc, you can implement yyerror to do nothing and
  * then call ReportError::Formatted yourself with a more descriptive
  * message.
  */
-void yyerror(const char *msg) {
-    ReportError::Formatted(&yylloc, "%s", msg);
+void yyerror(yyltype *loc, void *scanner, const char *msg) {
+    ReportError::Formatted(loc, "%s", msg);
 }
 
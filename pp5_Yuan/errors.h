@@ -34,7 +34,7 @@ class Operator;
  * on this class are static, thus you can invoke methods directly via
  * the class name, e.g.
  *
- *    if (missingEnd) ReportError::UntermString(&yylloc, str);
+ *    if (missingEnd) ReportError::UntermString(yylloc, str);
  *
  * For some methods, the first argument is the pointer to the location
  * structure that identifies where the problem is (usually this is the
@@ -108,14 +108,13 @@ class ReportError
     // Generic method to report a printf-style error message
     static void Formatted(yyltype *loc, const char *format, ...);
 
-    // Returns number of error messages printed
-    static int NumErrors() { return numErrors; }
+    // Returns number of error messages printed in this compilation
+    static int NumErrors();
 
   private:
 
     static void UnderlineErrorInLine(const char *line, yyltype *pos);
     static void OutputError(yyltype *loc, string msg);
-    static int numErrors;
 
 };
 
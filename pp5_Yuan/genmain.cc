@@ -0,0 +1,265 @@
+/* File: genmain.cc
+ * ----------------
+ * dcc-gen writes a synthetic Decaf program of a given size on stdout, for
+ * the compile benchmarks (see the compile-bench script):
+ *
+ *    dcc-gen [--classes N] [--methods M] [--depth D] [--interfaces I]
+ *            [--functions F] [--switch S] [--nesting B] [--length L]
+ *            [--seed X]
+ *
+ * The program has N classes in chains of D classes, each extending the
+ * one before, with M methods and M / 2 fields each and a method step
+ * overridden down the chain. I interfaces of one method are spread over
+ * the classes. There are F functions of each of three kinds: a switch of
+ * S cases, B blocks nested in each other, each with a local, and a body
+ * of L statements (assignments, ifs, loops and array stores). main
+ * creates an object of each class, calls all the methods, through the
+ * interfaces too, and the functions, and prints a checksum, so the
+ * program also runs, in a time about linear in its size. The same
+ * options and seed give the same program.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct Options {
+    int classes, methods, depth, interfaces, functions, cases, nesting,
+        length;
+    unsigned seed;
+};
+
+static unsigned state;
+
+/* A small LCG for the constants of the program, the same on every host.
+ */
+static int Random(int n) {
+    state = state * 1103515245 + 12345;
+    return (state >> 16) % n;
+}
+
+static void Usage() {
+    printf("Usage:   dcc-gen [--classes N] [--methods M] [--depth D] "
+           "[--interfaces I] [--functions F] [--switch S] [--nesting B] "
+           "[--length L] [--seed X]\n");
+    exit(2);
+}
+
+static void ParseCommandLine(int argc, char *argv[], Options *o) {
+    struct { const char *name; int *value; int min; } flags[] = {
+        { "--classes", &o->classes, 1 },
+        { "--methods", &o->methods, 1 },
+        { "--depth", &o->depth, 1 },
+        { "--interfaces", &o->interfaces, 0 },
+        { "--functions", &o->functions, 0 },
+        { "--switch", &o->cases, 1 },
+        { "--nesting", &o->nesting, 1 },
+        { "--length", &o->length, 1 },
+    };
+    int numFlags = sizeof(flags) / sizeof(flags[0]);
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 == argc) Usage();
+        if (strcmp(argv[i], "--seed") == 0) {
+            o->seed = strtoul(argv[i + 1], NULL, 10);
+            continue;
+        }
+        int f = 0;
+        while (f < numFlags && strcmp(argv[i], flags[f].name) != 0) f++;
+        if (f == numFlags) Usage();
+        char *end;
+        long v = strtol(argv[i + 1], &end, 10);
+        if (*end || v < flags[f].min || v > 1000000) Usage();
+        *flags[f].value = v;
+    }
+}
+
+/* The classes of a chain extend the one before, the first of each chain
+ * extends nothing.
+ */
+static bool IsRoot(const Options &o, int c) {
+    return c % o.depth == 0;
+}
+
+static void EmitInterfaces(const Options &o) {
+    for (int k = 0; k < o.interfaces; k++)
+        printf("interface I%d {\n    int op%d(int x);\n}\n\n", k, k);
+}
+
+static void EmitClass(const Options &o, int c) {
+    int numFields = o.methods / 2 > 0 ? o.methods / 2 : 1;
+    printf("class C%d", c);
+    if (!IsRoot(o, c)) printf(" extends C%d", c - 1);
+    const char *sep = " implements ";
+    for (int k = c; k < o.interfaces; k += o.classes) {
+        printf("%sI%d", sep, k);
+        sep = ", ";
+    }
+    printf(" {\n");
+    for (int f = 0; f < numFields; f++)
+        printf("    int f%d_%d;\n", c, f);
+
+    printf("\n    void set%d(int v) {\n", c);
+    for (int f = 0; f < numFields; f++)
+        printf("        f%d_%d = (v + %d) %% 10007;\n", c, f, Random(100));
+    printf("    }\n");
+
+    printf("\n    int step(int x) {\n");
+    printf("        return (x * %d + %d) %% 10007;\n", c % 7 + 1,
+           Random(1000));
+    printf("    }\n");
+
+    for (int m = 0; m < o.methods; m++) {
+        printf("\n    int m%d_%d(int x) {\n", c, m);
+        printf("        int t;\n");
+        printf("        t = (x * %d + f%d_%d) %% 10007;\n", Random(9) + 1,
+               c, m % numFields);
+        // a short chain of calls, so a call costs a bounded time.
+        if (m % 4 != 0) {
+            printf("        if (t > %d) {\n", Random(10007));
+            printf("            t = t - %d;\n", Random(100));
+            printf("        } else {\n");
+            printf("            t = (t + this.m%d_%d(t %% 7)) %% 10007;\n",
+                   c, m - 1);
+            printf("        }\n");
+        }
+        printf("        return t;\n");
+        printf("    }\n");
+    }
+
+    for (int k = c; k < o.interfaces; k += o.classes) {
+        printf("\n    int op%d(int x) {\n", k);
+        printf("        return (x + %d) %% 10007;\n", k);
+        printf("    }\n");
+    }
+    printf("}\n\n");
+}
+
+static void EmitSwitch(const Options &o, int n) {
+    printf("int sw%d(int x) {\n", n);
+    printf("    int r;\n");
+    printf("    switch (x %% %d) {\n", o.cases);
+    for (int k = 0; k < o.cases; k++) {
+        printf("      case %d:\n", k);
+        printf("        r = (x * %d + %d) %% 10007;\n", Random(50) + 1,
+               Random(1000));
+        printf("        break;\n");
+    }
+    printf("      default:\n");
+    printf("        r = 0;\n");
+    printf("    }\n");
+    printf("    return r;\n");
+    printf("}\n\n");
+}
+
+static void Indent(int level) {
+    printf("%*s", 4 * level, "");
+}
+
+static void EmitNested(const Options &o, int n) {
+    printf("int nest%d(int x) {\n", n);
+    printf("    int r;\n");
+    printf("    r = x;\n");
+    for (int b = 1; b <= o.nesting; b++) {
+        Indent(b);
+        printf("if (r >= %d) {\n", b % 2);
+        Indent(b + 1);
+        printf("int v%d;\n", b);
+        Indent(b + 1);
+        printf("v%d = (r + %d) %% 10007;\n", b, Random(100));
+        Indent(b + 1);
+        printf("r = (r + v%d) %% 10007;\n", b);
+    }
+    for (int b = o.nesting; b >= 1; b--) {
+        Indent(b);
+        printf("}\n");
+    }
+    printf("    return r;\n");
+    printf("}\n\n");
+}
+
+static void EmitLong(const Options &o, int n) {
+    printf("int long%d(int n) {\n", n);
+    printf("    int a;\n    int b;\n    int i;\n    int[] arr;\n");
+    printf("    a = n;\n    b = 1;\n    arr = NewArray(8, int);\n");
+    for (int s = 0; s < o.length; s++) {
+        switch (s % 5) {
+          case 0:
+            printf("    a = (a * %d + b) %% 10007;\n", Random(9) + 1);
+            break;
+          case 1:
+            printf("    b = (b + a %% %d) %% 10007;\n", Random(20) + 2);
+            break;
+          case 2:
+            printf("    if (a > b) {\n        a = a - b;\n"
+                   "    } else {\n        b = b - a;\n    }\n");
+            break;
+          case 3:
+            printf("    for (i = 0; i < %d; i = i + 1) {\n"
+                   "        a = (a + i) %% 10007;\n    }\n",
+                   Random(4) + 1);
+            break;
+          default:
+            printf("    arr[%d] = a + b;\n", Random(8));
+            printf("    b = (b + arr[%d]) %% 10007;\n", Random(8));
+            break;
+        }
+    }
+    printf("    return (a + b) %% 10007;\n");
+    printf("}\n\n");
+}
+
+static void EmitMain(const Options &o) {
+    printf("void main() {\n");
+    printf("    int sum;\n");
+    for (int c = 0; c < o.classes; c++)
+        printf("    C%d o%d;\n", c, c);
+    for (int k = 0; k < o.interfaces; k++)
+        printf("    I%d i%d;\n", k, k);
+    printf("    sum = 0;\n");
+    for (int c = 0; c < o.classes; c++) {
+        printf("    o%d = New(C%d);\n", c, c);
+        // the fields of the classes above in the chain too.
+        for (int p = c; ; p--) {
+            printf("    o%d.set%d(%d);\n", c, p, Random(1000));
+            if (IsRoot(o, p)) break;
+        }
+        printf("    sum = (sum + o%d.step(sum)) %% 10007;\n", c);
+        for (int m = 0; m < o.methods; m++)
+            printf("    sum = (sum + o%d.m%d_%d(sum)) %% 10007;\n", c, c, m);
+    }
+    for (int k = 0; k < o.interfaces; k++) {
+        // a class of the chain below the one implementing the interface.
+        int c = k % o.classes;
+        while (c + 1 < o.classes && !IsRoot(o, c + 1) && Random(2)) c++;
+        printf("    i%d = o%d;\n", k, c);
+        printf("    sum = (sum + i%d.op%d(sum)) %% 10007;\n", k, k);
+    }
+    for (int f = 0; f < o.functions; f++) {
+        printf("    sum = (sum + sw%d(sum)) %% 10007;\n", f);
+        printf("    sum = (sum + nest%d(sum)) %% 10007;\n", f);
+        printf("    sum = (sum + long%d(sum)) %% 10007;\n", f);
+    }
+    printf("    Print(\"checksum \", sum, \"\\n\");\n");
+    printf("}\n");
+}
+
+int main(int argc, char *argv[]) {
+    Options o = { 20, 8, 4, 8, 4, 64, 16, 200, 1 };
+    ParseCommandLine(argc, argv, &o);
+    state = o.seed;
+
+    printf("// dcc-gen");
+    for (int i = 1; i < argc; i++) printf(" %s", argv[i]);
+    printf("\n\n");
+    EmitInterfaces(o);
+    for (int c = 0; c < o.classes; c++) EmitClass(o, c);
+    for (int f = 0; f < o.functions; f++) {
+        EmitSwitch(o, f);
+        EmitNested(o, f);
+        EmitLong(o, f);
+    }
+    EmitMain(o);
+    return 0;
+}
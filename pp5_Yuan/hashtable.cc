@@ -16,7 +16,7 @@ template <class Value> void Hashtable<Value>::Enter(const char *key,
    Value prev;
    if (overwrite && (prev = Lookup(key)))
      Remove(key, prev);
-   mmap.insert(std::make_pair(strdup(key), val));
+   mmap.insert(std::make_pair(CopyString(key), val));
 }
 
 /* Hashtable::Remove
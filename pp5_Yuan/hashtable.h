@@ -35,6 +35,7 @@
 
 #include <map>
 #include <string.h>
+#include "utility.h"  // for CopyString
 
 struct ltstr
 {
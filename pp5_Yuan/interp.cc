@@ -0,0 +1,673 @@
+/* File: interp.cc
+ * ---------------
+ * Implementation of the Interpreter.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "interp.h"
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "errors.h"
+
+static const char Magic[4] = { 'D', 'B', 'C', '1' };
+static const uint32_t Version = 1;
+
+// the machine: the data segment and the heap grow up from DataBase, the
+// stack grows down from the end of the memory. The vars of a frame are
+// within MaxFrameOffset of fp, which is kept inside the stack, so they
+// need no check.
+static const uint32_t MemorySize = 64 << 20;
+static const uint32_t StackSize = 8 << 20;
+static const int32_t MaxFrameOffset = 1 << 20;
+static const int ReadLineSize = 128;    // as in defs.asm.
+
+Interpreter::Interpreter(FILE *o, std::ostream *e) {
+    memset(&header, 0, sizeof(header));
+    code = NULL;
+    dataImage = NULL;
+    mapped = NULL;
+    mappedSize = 0;
+    mem = NULL;
+    memSize = heap = heapLimit = 0;
+    out = o;
+    err = e;
+}
+
+Interpreter::~Interpreter() {
+    if (mapped) munmap(mapped, mappedSize);
+    free(mem);
+}
+
+int32_t Interpreter::OperandFor(Location *var) {
+    Assert(var != NULL && var->GetOffset() % 4 == 0);
+    int32_t offset = var->GetOffset();
+    if (var->GetSegment() == fpRelative) {
+        Assert(offset > -MaxFrameOffset && offset < MaxFrameOffset);
+        return offset;
+    }
+    if (offset + CodeGenerator::VarSize > (int)header.globalSize)
+        header.globalSize = offset + CodeGenerator::VarSize;
+    return offset | GP;
+}
+
+Interpreter::Op & Interpreter::NewOp(OpCode c) {
+    Op op;
+    memset(&op, 0, sizeof(op));
+    op.code = c;
+    ops.push_back(op);
+    return ops.back();
+}
+
+void Interpreter::AddFixup(const char *label, bool isData, bool isAddress) {
+    Fixup f;
+    f.index = isData ? data.size() : ops.size() - 1;
+    f.label = label;
+    f.isData = isData;
+    f.isAddress = isAddress;
+    fixups.push_back(f);
+}
+
+/*
+ * Adds a word with the address of a label to the data.
+ */
+void Interpreter::AddWord(const char *label) {
+    if (label && strcmp(label, "0")) AddFixup(label, true, true);
+    data.resize(data.size() + 4, 0);
+}
+
+void Interpreter::EmitLoadConstant(Location *dst, int val) {
+    Op &op = NewOp(B_Const);
+    op.dst = OperandFor(dst);
+    op.b = val;
+}
+
+/*
+ * The string is quoted, its escapes are those of the .asciiz of spim.
+ */
+void Interpreter::EmitLoadStringConstant(Location *dst, const char *str) {
+    Op &op = NewOp(B_Const);
+    op.dst = OperandFor(dst);
+    op.b = DataBase + data.size();
+    int len = strlen(str);
+    for (int i = 1; i < len - 1; i++) {
+        char c = str[i];
+        if (c == '\\' && i + 1 < len - 1) {
+            switch (str[++i]) {
+              case 'n': c = '\n'; break;
+              case 't': c = '\t'; break;
+              case '"': c = '"'; break;
+              case '\\': c = '\\'; break;
+              default: data.push_back('\\'); c = str[i]; break;
+            }
+        }
+        data.push_back(c);
+    }
+    data.push_back('\0');
+    data.resize((data.size() + 3) & ~3, 0);
+}
+
+void Interpreter::EmitLoadLabel(Location *dst, const char *label) {
+    Op &op = NewOp(B_Const);
+    op.dst = OperandFor(dst);
+    AddFixup(label, false, true);
+}
+
+void Interpreter::EmitLoad(Location *dst, Location *reference, int offset) {
+    Op &op = NewOp(B_Load);
+    op.dst = OperandFor(dst);
+    op.a = OperandFor(reference);
+    op.b = offset;
+}
+
+void Interpreter::EmitStore(Location *reference, Location *value,
+                            int offset) {
+    Op &op = NewOp(B_Store);
+    op.dst = OperandFor(reference);
+    op.a = OperandFor(value);
+    op.b = offset;
+}
+
+void Interpreter::EmitCopy(Location *dst, Location *src) {
+    Op &op = NewOp(B_Copy);
+    op.dst = OperandFor(dst);
+    op.a = OperandFor(src);
+}
+
+void Interpreter::EmitBinaryOp(BinaryOp::OpCode c, Location *dst,
+        Location *op1, Location *op2)
+{
+    Op &op = NewOp((OpCode)(B_Add + c));
+    op.dst = OperandFor(dst);
+    op.a = OperandFor(op1);
+    op.b = OperandFor(op2);
+}
+
+void Interpreter::EmitLabel(const char *label) {
+    codeLabels[label] = ops.size();
+}
+
+void Interpreter::EmitGoto(const char *label) {
+    NewOp(B_Goto);
+    AddFixup(label, false, false);
+}
+
+void Interpreter::EmitIfZ(Location *test, const char *label) {
+    Op &op = NewOp(B_IfZ);
+    op.a = OperandFor(test);
+    AddFixup(label, false, false);
+}
+
+void Interpreter::EmitIfNZ(Location *test, const char *label) {
+    Op &op = NewOp(B_IfNZ);
+    op.a = OperandFor(test);
+    AddFixup(label, false, false);
+}
+
+void Interpreter::EmitReturn(Location *returnVal) {
+    Op &op = NewOp(B_Return);
+    if (returnVal) {
+        op.aux = 1;
+        op.a = OperandFor(returnVal);
+    }
+}
+
+void Interpreter::EmitBeginFunction(int frameSize) {
+    Assert(frameSize >= 0 && frameSize < MaxFrameOffset);
+    NewOp(B_BeginFunc).b = frameSize;
+}
+
+void Interpreter::EmitEndFunction() {
+    EmitReturn(NULL);
+}
+
+void Interpreter::EmitParam(Location *arg) {
+    NewOp(B_Param).a = OperandFor(arg);
+}
+
+/*
+ * The result of a call is copied from v0 by the op after the call, where
+ * the callee returns to.
+ */
+void Interpreter::EmitLCall(Location *result, const char *label) {
+    NewOp(B_LCall);
+    AddFixup(label, false, false);
+    if (result) NewOp(B_Result).dst = OperandFor(result);
+}
+
+void Interpreter::EmitACall(Location *result, Location *fnAddr) {
+    NewOp(B_ACall).a = OperandFor(fnAddr);
+    if (result) NewOp(B_Result).dst = OperandFor(result);
+}
+
+void Interpreter::EmitPopParams(int bytes) {
+    if (bytes != 0) NewOp(B_PopParams).b = bytes;
+}
+
+/*
+ * The interface tables are laid out below the vtable, as in the assembly,
+ * see Mips::EmitVTable.
+ */
+void Interpreter::EmitVTable(const char *label,
+        List<const char*> *methodLabels, List<const char*> *itableLabels) {
+    if (itableLabels) {
+        for (int i = itableLabels->NumElements() - 1; i >= 0; i--)
+            AddWord(itableLabels->Nth(i));
+    }
+    dataLabels[label] = data.size();
+    for (int i = 0; i < methodLabels->NumElements(); i++)
+        AddWord(methodLabels->Nth(i));
+}
+
+void Interpreter::EmitITable(const char *label,
+        List<const char*> *methodLabels) {
+    dataLabels[label] = data.size();
+    for (int i = 0; i < methodLabels->NumElements(); i++)
+        AddWord(methodLabels->Nth(i));
+}
+
+void Interpreter::EmitProfileTable(const char *label, const char *function,
+        int numCounters) {
+    uint32_t name = DataBase + data.size();
+    data.insert(data.end(), function, function + strlen(function) + 1);
+    data.resize((data.size() + 3) & ~3, 0);
+    dataLabels[label] = data.size();
+    data.resize(data.size() + 8 + 4 * numCounters, 0);
+    memcpy(&data[dataLabels[label]], &name, 4);
+    memcpy(&data[dataLabels[label] + 4], &numCounters, 4);
+}
+
+/*
+ * Resolves the labels. A call to a label which is not in the program is a
+ * call to a built-in function, as the program is linked with defs.asm.
+ */
+bool Interpreter::Link() {
+    for (size_t i = 0; i < fixups.size(); i++) {
+        Fixup &f = fixups[i];
+        std::map<std::string, int>::iterator c = codeLabels.find(f.label);
+        std::map<std::string, int>::iterator d = dataLabels.find(f.label);
+        int32_t value;
+        if (f.isAddress && d != dataLabels.end()) {
+            value = DataBase + d->second;
+        } else if (c != codeLabels.end()) {
+            value = f.isAddress ? TextBase + c->second : c->second;
+        } else {
+            int b = 0;
+            while (b < NumBuiltIns &&
+                   strcmp(f.label, CodeGenerator::BuiltInLabel((BuiltIn)b)))
+                b++;
+            if (f.isData || b == NumBuiltIns ||
+                ops[f.index].code != B_LCall) {
+                ReportError::Formatted(NULL, "Undefined label %s.", f.label);
+                return false;
+            }
+            ops[f.index].code = B_BuiltIn;
+            ops[f.index].aux = b;
+            continue;
+        }
+        if (f.isData)
+            memcpy(&data[f.index], &value, sizeof(value));
+        else
+            ops[f.index].b = value;
+    }
+    if (!codeLabels.count("main")) {
+        ReportError::Formatted(NULL, "Undefined label main.");
+        return false;
+    }
+    return true;
+}
+
+bool Interpreter::Finish() {
+    if (!Link()) return false;
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.opSize = sizeof(Op);
+    header.numOps = ops.size();
+    header.dataSize = data.size();
+    header.entry = codeLabels["main"];
+    code = &ops[0];
+    dataImage = data.empty() ? NULL : &data[0];
+    Assert(Validate());
+    return true;
+}
+
+bool Interpreter::Write(const char *file) {
+    FILE *fp = fopen(file, "w");
+    if (!fp) return false;
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(code, sizeof(Op), header.numOps, fp);
+    fwrite(dataImage, 1, header.dataSize, fp);
+    return fclose(fp) == 0;
+}
+
+bool Interpreter::Map(const char *file) {
+    int fd = open(file, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+        if (fd >= 0) close(fd);
+        *err << "*** Cannot read bytecode file " << file << "." << std::endl;
+        return false;
+    }
+    mappedSize = st.st_size;
+    mapped = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        mapped = NULL;
+        *err << "*** Cannot read bytecode file " << file << "." << std::endl;
+        return false;
+    }
+    memcpy(&header, mapped, sizeof(header));
+    code = (const Op *)((const char *)mapped + sizeof(Header));
+    dataImage = (const char *)(code + header.numOps);
+    if (memcmp(header.magic, Magic, sizeof(Magic)) ||
+        header.version != Version || header.opSize != sizeof(Op) ||
+        header.numOps > (mappedSize - sizeof(Header)) / sizeof(Op) ||
+        sizeof(Header) + header.numOps * sizeof(Op) + header.dataSize !=
+            mappedSize || !Validate()) {
+        *err << "*** " << file << " is not a valid bytecode file."
+             << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Checks that the ops stay in the code and in the frame or the global
+ * vars, so the machine needs to check the memory accesses through
+ * pointers only.
+ */
+bool Interpreter::Validate() {
+    const Header &h = header;
+    if (h.numOps == 0 || h.entry >= h.numOps || h.globalSize % 4 ||
+        h.globalSize > MemorySize || h.dataSize > MemorySize)
+        return false;
+    auto var = [&](int32_t v) {
+        if (v & GP) return v - GP >= 0 && (uint32_t)(v - GP) < h.globalSize;
+        return v % 4 == 0 && v > -MaxFrameOffset && v < MaxFrameOffset;
+    };
+    for (uint32_t i = 0; i < h.numOps; i++) {
+        const Op &op = code[i];
+        bool ok;
+        switch (op.code) {
+          case B_Const: case B_Result:
+            ok = var(op.dst);
+            break;
+          case B_Copy: case B_Load: case B_Store:
+            ok = var(op.dst) && var(op.a);
+            break;
+          case B_Goto: case B_LCall:
+            ok = (uint32_t)op.b < h.numOps;
+            break;
+          case B_IfZ: case B_IfNZ:
+            ok = var(op.a) && (uint32_t)op.b < h.numOps;
+            break;
+          case B_BeginFunc:
+            ok = op.b >= 0 && op.b < MaxFrameOffset;
+            break;
+          case B_Return:
+            ok = !op.aux || var(op.a);
+            break;
+          case B_Param: case B_ACall:
+            ok = var(op.a);
+            break;
+          case B_PopParams:
+            ok = op.b >= 0 && op.b < MaxFrameOffset;
+            break;
+          case B_BuiltIn:
+            ok = op.aux < NumBuiltIns;
+            break;
+          default:
+            ok = op.code >= B_Add && op.code <= B_Or && var(op.dst) &&
+                 var(op.a) && var(op.b);
+            break;
+        }
+        if (!ok) return false;
+    }
+    // the code does not fall off its end.
+    uint16_t last = code[h.numOps - 1].code;
+    return last == B_Goto || last == B_Return;
+}
+
+int Interpreter::RuntimeError(const char *format, ...) {
+    va_list args;
+    char buf[256];
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    fflush(out);
+    *err << "*** Runtime error: " << buf << std::endl;
+    return 1;
+}
+
+/*
+ * Finds the null terminated string at addr.
+ */
+bool Interpreter::CString(uint32_t addr, const char **s) {
+    if (!Valid(addr, 1) ||
+        !memchr(&Word(addr), '\0', memSize - (addr - DataBase)))
+        return false;
+    *s = (const char *)&Word(addr);
+    return true;
+}
+
+/*
+ * Does a built-in function with the params at sp. Returns false after a
+ * runtime error.
+ */
+bool Interpreter::BuiltInCall(BuiltIn b, uint32_t sp, int32_t *result,
+                              bool *halt) {
+    int32_t arg1 = Word(sp + 4);
+    const char *s1, *s2;
+    char line[64];
+    switch (b) {
+      case Alloc: {
+        uint32_t size = ((uint32_t)arg1 + 3) & ~3;
+        if (arg1 < 0 || size > heapLimit - heap) {
+            RuntimeError("Out of memory, cannot allocate %d bytes.", arg1);
+            return false;
+        }
+        *result = heap;
+        heap += size;
+        return true;
+      }
+      case ReadLine: {
+        if (heapLimit - heap < ReadLineSize) {
+            RuntimeError("Out of memory, cannot read a line.");
+            return false;
+        }
+        *result = heap;
+        char *buf = (char *)&Word(heap);
+        heap += ReadLineSize;
+        fflush(out);
+        if (!fgets(buf, ReadLineSize, stdin)) *buf = '\0';
+        size_t len = strlen(buf);
+        if (len > 0 && buf[len - 1] == '\n') buf[len - 1] = '\0';
+        return true;
+      }
+      case ReadInteger:
+        fflush(out);
+        *result = fgets(line, sizeof(line), stdin) ? atoi(line) : 0;
+        return true;
+      case StringEqual:
+        if (!CString(arg1, &s1) || !CString(Word(sp + 8), &s2)) {
+            RuntimeError("Bad string address in StringEqual.");
+            return false;
+        }
+        *result = strcmp(s1, s2) == 0;
+        return true;
+      case PrintInt:
+        fprintf(out, "%d", arg1);
+        return true;
+      case PrintString:
+        if (!CString(arg1, &s1)) {
+            RuntimeError("Bad string address 0x%08x in PrintString.", arg1);
+            return false;
+        }
+        fputs(s1, out);
+        return true;
+      case PrintBool:
+        fputs(arg1 > 0 ? "true" : "false", out);
+        return true;
+      case Halt:
+        *halt = true;
+        return true;
+      case DumpProfile:
+        // the tables of the profile counters, see CodeGenerator::Instrument.
+        fputs("\n# profile\n", out);
+        for (uint32_t dir = arg1; Valid(dir, 4) && Word(dir) != 0; dir += 4) {
+            uint32_t table = Word(dir);
+            if (!Valid(table, 8) || !CString(Word(table), &s1) ||
+                !Valid(table + 8, 4 * (uint32_t)Word(table + 4))) {
+                RuntimeError("Bad profile table 0x%08x.", table);
+                return false;
+            }
+            for (int i = 0; i < Word(table + 4); i++)
+                fprintf(out, "%s %d %d\n", s1, i, Word(table + 8 + 4 * i));
+        }
+        return true;
+      default:
+        Assert(0);
+        return false;
+    }
+}
+
+// a var of the op, see Op.
+#define VAR(v) (*(int32_t *)(base[(v) & GP] + ((v) & ~GP)))
+// the next op, by the computed goto of its code.
+#define NEXT() do { op = ip++; goto *dispatch[op->code]; } while (0)
+
+int Interpreter::Run() {
+    // lay out the data, the globals after it, and the heap.
+    memSize = MemorySize;
+    uint32_t dataSize = (header.dataSize + 3) & ~3;
+    heapLimit = DataBase + memSize - StackSize - MaxFrameOffset;
+    if (dataSize + header.globalSize > heapLimit - DataBase)
+        return RuntimeError("The program does not fit in memory.");
+    mem = (char *)calloc(memSize, 1);
+    if (!mem) return RuntimeError("Cannot allocate the memory.");
+    if (header.dataSize > 0) memcpy(mem, dataImage, header.dataSize);
+    heap = DataBase + dataSize + header.globalSize;
+
+    // the registers, fp, gp and sp point in mem. main returns to 0.
+    char *base[2];
+    char *stackLimit = mem + memSize - StackSize;
+    char *top = mem + memSize - MaxFrameOffset;
+    char *sp = top;
+    base[FP] = sp;
+    base[GP] = mem + dataSize;
+    int32_t ra = 0, v0 = 0;
+    const Op *ip = code + header.entry, *op;
+    const uint32_t numOps = header.numOps;
+
+    // in the order of OpCode.
+    static const void *dispatch[NumOpCodes] = {
+        &&Const, &&Copy, &&Load, &&Store,
+        &&Add, &&Sub, &&Mul, &&Div, &&Mod,
+        &&Eq, &&Ne, &&Lt, &&Le, &&Gt, &&Ge,
+        &&And, &&Or,
+        &&Goto, &&IfZ, &&BeginFunc, &&Return, &&Param, &&PopParams,
+        &&LCall, &&ACall, &&Result, &&BuiltIn, &&IfNZ
+    };
+    NEXT();
+
+  Const:
+    VAR(op->dst) = op->b;
+    NEXT();
+  Copy:
+    VAR(op->dst) = VAR(op->a);
+    NEXT();
+  Load: {
+    uint32_t addr = VAR(op->a) + op->b;
+    if (!Valid(addr, 4) || addr % 4)
+        return RuntimeError("Bad address 0x%08x in load.", addr);
+    VAR(op->dst) = Word(addr);
+    NEXT();
+  }
+  Store: {
+    uint32_t addr = VAR(op->dst) + op->b;
+    if (!Valid(addr, 4) || addr % 4)
+        return RuntimeError("Bad address 0x%08x in store.", addr);
+    Word(addr) = VAR(op->a);
+    NEXT();
+  }
+  Add:
+    VAR(op->dst) = (uint32_t)VAR(op->a) + (uint32_t)VAR(op->b);
+    NEXT();
+  Sub:
+    VAR(op->dst) = (uint32_t)VAR(op->a) - (uint32_t)VAR(op->b);
+    NEXT();
+  Mul:
+    VAR(op->dst) = (uint32_t)VAR(op->a) * (uint32_t)VAR(op->b);
+    NEXT();
+  Div: {
+    int32_t y = VAR(op->b);
+    if (y == 0) return RuntimeError("Division by zero.");
+    // no overflow, as on MIPS.
+    VAR(op->dst) = y == -1 ? -(uint32_t)VAR(op->a) : VAR(op->a) / y;
+    NEXT();
+  }
+  Mod: {
+    int32_t y = VAR(op->b);
+    if (y == 0) return RuntimeError("Division by zero.");
+    VAR(op->dst) = y == -1 ? 0 : VAR(op->a) % y;
+    NEXT();
+  }
+  Eq:
+    VAR(op->dst) = VAR(op->a) == VAR(op->b);
+    NEXT();
+  Ne:
+    VAR(op->dst) = VAR(op->a) != VAR(op->b);
+    NEXT();
+  Lt:
+    VAR(op->dst) = VAR(op->a) < VAR(op->b);
+    NEXT();
+  Le:
+    VAR(op->dst) = VAR(op->a) <= VAR(op->b);
+    NEXT();
+  Gt:
+    VAR(op->dst) = VAR(op->a) > VAR(op->b);
+    NEXT();
+  Ge:
+    VAR(op->dst) = VAR(op->a) >= VAR(op->b);
+    NEXT();
+  And:
+    VAR(op->dst) = VAR(op->a) & VAR(op->b);
+    NEXT();
+  Or:
+    VAR(op->dst) = VAR(op->a) | VAR(op->b);
+    NEXT();
+  Goto:
+    ip = code + op->b;
+    NEXT();
+  IfZ:
+    if (VAR(op->a) == 0) ip = code + op->b;
+    NEXT();
+  IfNZ:
+    if (VAR(op->a) != 0) ip = code + op->b;
+    NEXT();
+  BeginFunc:
+    if (sp - stackLimit < 8 + op->b) return RuntimeError("Stack overflow.");
+    sp -= 8;
+    *(int32_t *)(sp + 8) = DataBase + (base[FP] - mem);
+    *(int32_t *)(sp + 4) = ra;
+    base[FP] = sp + 8;
+    sp -= op->b;
+    NEXT();
+  Return: {
+    if (op->aux) v0 = VAR(op->a);
+    sp = base[FP];
+    ra = *(int32_t *)(sp - 4);
+    if (ra == 0) {
+        fflush(out);
+        return 0;
+    }
+    // the saved registers may have been overwritten through a pointer.
+    uint32_t fp = *(int32_t *)sp;
+    if ((uint32_t)(ra - TextBase) >= numOps || fp % 4 ||
+        fp - DataBase < (uint32_t)(stackLimit - mem) ||
+        fp - DataBase > (uint32_t)(top - mem))
+        return RuntimeError("Bad frame at return.");
+    base[FP] = mem + (fp - DataBase);
+    ip = code + (ra - TextBase);
+    NEXT();
+  }
+  Param:
+    if (sp - stackLimit < 4) return RuntimeError("Stack overflow.");
+    sp -= 4;
+    *(int32_t *)(sp + 4) = VAR(op->a);
+    NEXT();
+  PopParams:
+    if (top - sp < op->b) return RuntimeError("Stack underflow.");
+    sp += op->b;
+    NEXT();
+  LCall:
+    ra = TextBase + (ip - code);
+    ip = code + op->b;
+    NEXT();
+  ACall: {
+    uint32_t index = VAR(op->a) - TextBase;
+    if (index >= numOps)
+        return RuntimeError("Bad address 0x%08x in call.", VAR(op->a));
+    ra = TextBase + (ip - code);
+    ip = code + index;
+    NEXT();
+  }
+  Result:
+    VAR(op->dst) = v0;
+    NEXT();
+  BuiltIn: {
+    bool halt = false;
+    if (!BuiltInCall((BuiltIn)op->aux, DataBase + (sp - mem), &v0, &halt))
+        return 1;
+    if (halt) {
+        fflush(out);
+        return 0;
+    }
+    NEXT();
+  }
+}
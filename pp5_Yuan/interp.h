@@ -0,0 +1,185 @@
+/* File: interp.h
+ * --------------
+ * The Interpreter runs the Tac of a program in the compiler, without
+ * going through the assembly and spim, or writes it as a bytecode file
+ * which is run later:
+ *
+ *    dcc [<file>] --run
+ *    dcc [<file>] --emit-bytecode <prog.dbc>
+ *    dcc --exec <prog.dbc>
+ *
+ * It is a Target of the final code generation (see target.h): each Tac
+ * instruction is emitted into it, which lowers the instruction into
+ * a bytecode op of 16 bytes. The vars of an op are registers, their
+ * offsets in the frame or in the global vars, the constants, offsets and
+ * branch targets are inline. The string constants, the vtables and the
+ * interface tables are laid out in a data image, the tables hold the
+ * indexes of the methods, and an ACall is an indirect call to the index
+ * found in a table.
+ *
+ * The bytecode file is a header, the ops and the data image. It is mapped
+ * and the ops are run in place, only the data is copied into the memory
+ * of the machine. The ops are dispatched by computed gotos, one indirect
+ * jump at the end of each op.
+ *
+ * The machine is the one of the MIPS code: 4 byte words in a 32-bit
+ * address space, a data segment with the constants, the global vars and
+ * the heap, a stack that grows down, and the same calling protocol, so
+ * the frames and the layout of the objects are those of the assembly.
+ * The built-in functions of defs.asm (Alloc, ReadLine, ReadInteger,
+ * StringEqual, Print* and Halt) are done natively. A bad memory access,
+ * a division by zero, a call through a bad address and a stack or heap
+ * overflow stop the program with a runtime error.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_interp
+#define _H_interp
+
+#include <stdint.h>
+#include <stdio.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "tac.h"
+#include "codegen.h"
+#include "list.h"
+#include "target.h"
+
+class Interpreter : public Target
+{
+  public:
+    typedef enum {
+        B_Const, B_Copy, B_Load, B_Store,
+        B_Add, B_Sub, B_Mul, B_Div, B_Mod,     // in the order of
+        B_Eq, B_Ne, B_Lt, B_Le, B_Gt, B_Ge,    // BinaryOp::OpCode.
+        B_And, B_Or,
+        B_Goto, B_IfZ, B_BeginFunc, B_Return, B_Param, B_PopParams,
+        B_LCall, B_ACall, B_Result, B_BuiltIn, B_IfNZ, NumOpCodes
+    } OpCode;
+
+    // a var is its byte offset from fp or gp, with the bit GP set for gp,
+    // the offsets are multiples of 4.
+    enum { FP, GP };
+
+    struct Op {
+        uint16_t code;              // OpCode.
+        uint16_t aux;               // the BuiltIn, or 1 if a return has a
+                                    // value.
+        int32_t dst, a;             // vars.
+        int32_t b;                  // a var, or the constant, the offset,
+                                    // the frame size or the target.
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t opSize;
+        uint32_t numOps;
+        uint32_t dataSize;
+        uint32_t globalSize;
+        uint32_t entry;             // the index of main.
+    };
+
+    // the addresses of the code and of the data segment, as in spim. The
+    // address of the op at index i is TextBase + i.
+    static const uint32_t TextBase = 0x00400000, DataBase = 0x10000000;
+
+  protected:
+    // a label used before it is known, patched by Link.
+    struct Fixup {
+        int index;                  // of the op, or of the data word.
+        const char *label;
+        bool isData;
+        bool isAddress;             // a code label as an address, not an
+                                    // index.
+    };
+
+    // the program, made by the Emit methods or mapped from a file.
+    std::vector<Op> ops;
+    std::vector<char> data;         // the constants and the tables.
+    std::map<std::string, int> codeLabels, dataLabels;
+    std::vector<Fixup> fixups;
+    Header header;
+    const Op *code;
+    const char *dataImage;
+    void *mapped;
+    size_t mappedSize;
+
+    // the machine.
+    char *mem;
+    uint32_t memSize, heap, heapLimit, stackLimit;
+    FILE *out;
+    std::ostream *err;
+
+    int32_t OperandFor(Location *var);
+    Op & NewOp(OpCode code);
+    void AddFixup(const char *label, bool isData, bool isAddress);
+    void AddWord(const char *label);
+    bool Link();
+    bool Validate();
+    int RuntimeError(const char *format, ...);
+
+    bool Valid(uint32_t addr, uint32_t size) {
+        return addr - DataBase < memSize && size <= memSize -
+               (addr - DataBase);
+    }
+    int32_t & Word(uint32_t addr) {
+        return *(int32_t *)(mem + (addr - DataBase));
+    }
+    bool CString(uint32_t addr, const char **s);
+    bool BuiltInCall(BuiltIn b, uint32_t sp, int32_t *result, bool *halt);
+
+  public:
+    Interpreter(FILE *out, std::ostream *err);
+    ~Interpreter();
+
+    void EmitLoadConstant(Location *dst, int val);
+    void EmitLoadStringConstant(Location *dst, const char *str);
+    void EmitLoadLabel(Location *dst, const char *label);
+
+    void EmitLoad(Location *dst, Location *reference, int offset);
+    void EmitStore(Location *reference, Location *value, int offset);
+    void EmitCopy(Location *dst, Location *src);
+
+    void EmitBinaryOp(BinaryOp::OpCode code, Location *dst,
+            Location *op1, Location *op2);
+
+    void EmitLabel(const char *label);
+    void EmitGoto(const char *label);
+    void EmitIfZ(Location *test, const char*label);
+    void EmitIfNZ(Location *test, const char*label);
+    void EmitReturn(Location *returnVal);
+
+    void EmitBeginFunction(int frameSize);
+    void EmitEndFunction();
+
+    void EmitParam(Location *arg);
+    void EmitLCall(Location *result, const char* label);
+    void EmitACall(Location *result, Location *fnAddr);
+    void EmitPopParams(int bytes);
+
+    void EmitVTable(const char *label, List<const char*> *methodLabels,
+                    List<const char*> *itableLabels = NULL);
+    void EmitITable(const char *label, List<const char*> *methodLabels);
+    void EmitProfileTable(const char *label, const char *function,
+                          int numCounters);
+
+    // resolves the labels of the emitted program, returns false if some
+    // label is not defined.
+    bool Finish();
+    // writes the emitted program to a bytecode file, returns false if it
+    // cannot be written.
+    bool Write(const char *file);
+    // maps a bytecode file, returns false if it is not a valid one.
+    bool Map(const char *file);
+
+    // runs the program from main, with the given input and output, and
+    // returns its exit status: 0 when main returns or the program halts,
+    // 1 after a runtime error.
+    int Run();
+};
+
+#endif
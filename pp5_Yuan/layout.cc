@@ -0,0 +1,130 @@
+/* File: layout.cc
+ * ---------------
+ * Implementation of ClassLayout.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "layout.h"
+#include "ast_decl.h"
+#include "codegen.h"
+#include "utility.h"
+#include "trace.h"
+
+ClassLayout::ClassLayout(ClassDecl *o, ClassLayout *parent) {
+    Assert(o != NULL);
+    owner = o;
+    vtable = new List<FnDecl*>;
+    fields = new List<VarDecl*>;
+    interfaces = new List<InterfaceDecl*>;
+    if (parent) {
+        // start from a copy of the parent's layout.
+        for (int i = 0; i < parent->NumMethods(); i++) {
+            vtable->Append(parent->GetMethod(i));
+        }
+        for (int i = 0; i < parent->NumFields(); i++) {
+            fields->Append(parent->GetField(i));
+        }
+        for (int i = 0; i < parent->NumInterfaces(); i++) {
+            interfaces->Append(parent->GetInterface(i));
+        }
+        methods = new Hashtable<FnDecl*>(*parent->methods);
+        members = new Hashtable<Decl*>(*parent->members);
+    } else {
+        methods = new Hashtable<FnDecl*>;
+        members = new Hashtable<Decl*>;
+    }
+}
+
+/*
+ * Append an instance var, the offset 0 is the vtable pointer.
+ */
+void ClassLayout::AddField(VarDecl *var) {
+    fields->Append(var);
+    members->Enter(var->GetId()->GetIdName(), var);
+    int offset = CodeGenerator::VarSize * fields->NumElements();
+    var->AssignMemberOffset(true, offset);
+}
+
+/*
+ * Append a new method slot, or replace the parent's method in place, so
+ * that the order of the methods is compatible with both of them.
+ */
+void ClassLayout::AddMethod(FnDecl *fn) {
+    const char *name = fn->GetId()->GetIdName();
+    FnDecl *prev = methods->Lookup(name);
+    int slot = vtable->NumElements();
+    if (prev) {
+        for (int i = 0; i < vtable->NumElements(); i++) {
+            if (vtable->Nth(i) == prev) slot = i;
+        }
+    }
+    if (slot < vtable->NumElements()) {
+        vtable->RemoveAt(slot);
+        vtable->InsertAt(fn, slot);
+    } else {
+        vtable->Append(fn);
+    }
+    methods->Enter(name, fn);
+    members->Enter(name, fn);
+    fn->AssignMemberOffset(true, CodeGenerator::VarSize * slot);
+}
+
+void ClassLayout::AddInterface(InterfaceDecl *itfc) {
+    for (int i = 0; i < interfaces->NumElements(); i++) {
+        if (interfaces->Nth(i) == itfc) return;
+    }
+    interfaces->Append(itfc);
+}
+
+void ClassLayout::Print() {
+    Trace(T_Layout, "Class Methods of %s:", owner->GetId()->GetIdName());
+    for (int i = 0; i < vtable->NumElements(); i++) {
+        Trace(T_Layout, "%d: %s", i * CodeGenerator::VarSize,
+                vtable->Nth(i)->GetId()->GetIdName());
+    }
+    Trace(T_Layout, "Class Vars of %s:", owner->GetId()->GetIdName());
+    for (int i = 0; i < fields->NumElements(); i++) {
+        Trace(T_Layout, "%d: %s", (i + 1) * CodeGenerator::VarSize,
+                fields->Nth(i)->GetId()->GetIdName());
+    }
+    for (int i = 0; i < interfaces->NumElements(); i++) {
+        Trace(T_Layout, "Interface %s",
+                interfaces->Nth(i)->GetId()->GetIdName());
+    }
+}
+
+int ClassLayout::GetInstanceSize() {
+    // the vtable pointer and the instance vars.
+    return CodeGenerator::VarSize * (fields->NumElements() + 1);
+}
+
+int ClassLayout::GetVTableSize() {
+    return CodeGenerator::VarSize * vtable->NumElements();
+}
+
+/*
+ * The labels of the vtable slots. Valid after the methods are prefixed.
+ */
+List<const char*> * ClassLayout::GetMethodLabels() {
+    List<const char*> *labels = new List<const char*>;
+    for (int i = 0; i < vtable->NumElements(); i++) {
+        labels->Append(vtable->Nth(i)->GetId()->GetIdName());
+    }
+    return labels;
+}
+
+/*
+ * The labels of the implementations of the interface methods, in the order
+ * of the interface. Valid after the methods are prefixed.
+ */
+List<const char*> * ClassLayout::GetITableLabels(InterfaceDecl *itfc) {
+    List<const char*> *labels = new List<const char*>;
+    List<Decl*> *m = itfc->GetMembers();
+    for (int i = 0; i < m->NumElements(); i++) {
+        FnDecl *fn = methods->Lookup(m->Nth(i)->GetId()->GetIdName());
+        Assert(fn); // checked by ClassDecl::CheckImplements.
+        labels->Append(fn->GetId()->GetIdName());
+    }
+    return labels;
+}
@@ -0,0 +1,71 @@
+/* File: layout.h
+ * --------------
+ * The ClassLayout records the run-time layout of a class object: the
+ * method slots of its vtable (inherited slots first, overridden methods
+ * replace the parent's entry in place), the instance variables with their
+ * offsets, and the instance size.
+ *
+ * The layout of a class is computed exactly once, at the end of the
+ * inheritance check, starting from a copy of its parent's layout. Hence
+ * the vtable of a class is always an extension of its parent's vtable.
+ * The semantic checker and the code generator both read the layout, so
+ * neither of them walks the inheritance chain again.
+ *
+ * For each interface implemented by the class, the code generator emits
+ * an interface table with the implementations of the interface methods
+ * in the order of the interface. The vtable is preceded by a directory of
+ * these tables indexed by the interface number, so an interface call is
+ * three loads: vtable = *obj, itable = *(vtable - 4 * (n + 1)), and the
+ * method = *(itable + 4 * slot).
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_layout
+#define _H_layout
+
+#include "list.h"
+#include "hashtable.h"
+
+class Decl;
+class ClassDecl;
+class VarDecl;
+class FnDecl;
+class InterfaceDecl;
+
+class ClassLayout
+{
+  protected:
+    ClassDecl *owner;
+    List<FnDecl*> *vtable;          // method slots, parent's slots first.
+    List<VarDecl*> *fields;         // instance vars, parent's vars first.
+    Hashtable<FnDecl*> *methods;    // method name -> implementation.
+    Hashtable<Decl*> *members;      // name -> nearest var or method.
+    List<InterfaceDecl*> *interfaces; // implemented, parent's included.
+
+  public:
+    // constructor, the parent layout can be NULL.
+    ClassLayout(ClassDecl *owner, ClassLayout *parent);
+    // build the layout of a class from its own members.
+    void AddField(VarDecl *var);
+    void AddMethod(FnDecl *fn);
+    void AddInterface(InterfaceDecl *itfc);
+    // print stuff.
+    void Print();
+    // lookup stuff.
+    FnDecl * LookupMethod(const char *name) { return methods->Lookup(name); }
+    Decl * LookupMember(const char *name) { return members->Lookup(name); }
+    int NumMethods() { return vtable->NumElements(); }
+    int NumFields() { return fields->NumElements(); }
+    FnDecl * GetMethod(int slot) { return vtable->Nth(slot); }
+    VarDecl * GetField(int i) { return fields->Nth(i); }
+    int NumInterfaces() { return interfaces->NumElements(); }
+    InterfaceDecl * GetInterface(int i) { return interfaces->Nth(i); }
+    // code generation stuff.
+    int GetInstanceSize();
+    int GetVTableSize();
+    List<const char*> * GetMethodLabels();
+    List<const char*> * GetITableLabels(InterfaceDecl *itfc);
+};
+
+#endif
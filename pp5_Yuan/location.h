@@ -2,9 +2,9 @@
  * ----------------
  * This file just contains features relative to the location structure
  * used to record the lexical position of a token or symbol.  This file
- * establishes the cmoon definition for the yyltype structure, the global
- * variable yylloc, and a utility function to join locations you might
- * find handy at times.
+ * establishes the cmoon definition for the yyltype structure, and a
+ * utility function to join locations you might find handy at times. The
+ * scanner and the parser are reentrant, so there is no global yylloc.
  */
 
 #ifndef YYLTYPE
@@ -23,13 +23,9 @@ typedef struct yyltype
 } yyltype;
 
 #define YYLTYPE yyltype
-
-/* Global variable: yylloc
- * ------------------------
- * The global variable holding the position information about the
- * lexeme just scanned.
- */
-extern struct yyltype yylloc;
+// a plain struct, so the parser may grow its stacks up to YYMAXDEPTH
+// rather than stop at YYINITDEPTH, which deeply nested blocks reach.
+#define YYLTYPE_IS_TRIVIAL 1
 
 /* Function: Join
  * --------------
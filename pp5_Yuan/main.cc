@@ -9,21 +9,65 @@
 #include "utility.h"
 #include "errors.h"
 #include "parser.h"
+#include "context.h"
+#include "batch.h"
+#include "server.h"
+#include "diskcache.h"
+#include "interp.h"
 
 /* Function: main()
  * ----------------
- * Entry point to the entire program.  We parse the command line and turn
- * on any debugging flags requested by the user when invoking the program.
- * InitScanner() is used to set up the scanner.
- * InitParser() is used to set up the parser. The call to yyparse() will
- * attempt to parse a complete program from the input.
+ * Entry point to the entire program.  We parse the command line into a
+ * compilation context, with the input file and any debugging flags
+ * requested by the user when invoking the program. Compile() sets up
+ * the scanner on the input file (or on stdin if no file is given) and
+ * the parser, then parses, checks and emits the program.
+ * With --batch, many files are compiled in parallel, see batch.h.
+ * With --server, dcc keeps running and compiles the programs sent by
+ * dcc --connect, see server.h. With --cache-dir, the result of a
+ * program compiled before is replayed from the cache, see diskcache.h.
+ * With --run, the program is run by the interpreter and its exit status
+ * is returned, and with --exec, a bytecode file written by
+ * --emit-bytecode is run, see interp.h.
  */
 int main(int argc, char *argv[]) {
-    ParseCommandLine(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        BatchCompiler batch;
+        batch.ParseCommandLine(argc, argv);
+        return batch.Run();
+    }
+    if (argc > 1 && strcmp(argv[1], "--server") == 0) {
+        CompileServer server;
+        server.ParseCommandLine(argc, argv);
+        return server.Run();
+    }
+    if (argc > 1 && strcmp(argv[1], "--exec") == 0) {
+        if (argc != 3) {
+            printf("Usage:   --exec <file>\n");
+            return 2;
+        }
+        Interpreter interp(stdout, &std::cerr);
+        if (!interp.Map(argv[2])) return 2;
+        return interp.Run();
+    }
+    if (argc > 1 && strcmp(argv[1], "--connect") == 0) {
+        CompileClient client;
+        client.ParseCommandLine(argc, argv);
+        return client.Run();
+    }
 
-    InitScanner();
-    InitParser();
-    yyparse();
-    return (ReportError::NumErrors() == 0 ? 0 : -1);
+    CompilationContext c;
+    ParseCommandLine(argc, argv, &c);
+
+    int numErrors;
+    if (c.cacheDir) {
+        DiskCache cache(c.cacheDir, c.cacheSize);
+        numErrors = cache.Compile(&c);
+    } else {
+        numErrors = c.Compile();
+    }
+    if (numErrors < 0) return 2; // cannot read the input.
+    if (numErrors == 0 && c.run) return c.runStatus;
+    return (numErrors == 0 ? 0 : -1);
 }
 
@@ -23,6 +23,8 @@
 #include <stdarg.h>
 #include <cstring>
 #include "mips.h"
+#include "context.h"
+#include "stats.h"
 
 // Helper to check if two variable locations are one and the same
 // (same name, segment, and offset)
@@ -44,6 +46,7 @@ void Mips::SpillRegister(Location *dst, Register reg) {
     const char *offsetFromWhere = dst->GetSegment() == fpRelative
         ? regs[fp].name : regs[gp].name;
     Assert(dst->GetOffset() % 4 == 0); // all variables are 4 bytes in size
+    Stats::Count(Stats::Spills);
     Emit("sw %s, %d(%s)\t# spill %s from %s to %s%+d", regs[reg].name,
             dst->GetOffset(), offsetFromWhere, dst->GetName(), regs[reg].name,
             offsetFromWhere,dst->GetOffset());
@@ -59,28 +62,14 @@ void Mips::FillRegister(Location *src, Register reg) {
     const char *offsetFromWhere = src->GetSegment() == fpRelative
         ? regs[fp].name : regs[gp].name;
     Assert(src->GetOffset() % 4 == 0); // all variables are 4 bytes in size
+    Stats::Count(Stats::Reloads);
     Emit("lw %s, %d(%s)\t# fill %s to %s from %s%+d", regs[reg].name,
             src->GetOffset(), offsetFromWhere, src->GetName(), regs[reg].name,
             offsetFromWhere,src->GetOffset());
 }
 
-/* Method: Emit
- * ------------
- * General purpose helper used to emit assembly instructions in
- * a reasonable tidy manner.  Takes printf-style formatting strings
- * and variable arguments.
- */
-void Mips::Emit(const char *fmt, ...) {
-    va_list args;
-    char buf[1024];
-
-    va_start(args, fmt);
-    vsprintf(buf, fmt, args);
-    va_end(args);
-    if (buf[strlen(buf) - 1] != ':') printf("\t"); // don't tab in labels
-    if (buf[0] != '#') printf("  ");   // outdent comments a little
-    printf("%s", buf);
-    if (buf[strlen(buf)-1] != '\n') printf("\n"); // end with a newline
+void Mips::EmitComment(const char *tac) {
+    Emit("# %s", tac);
 }
 
 /* Method: EmitLoadConstant
@@ -104,9 +93,8 @@ void Mips::EmitLoadConstant(Location *dst, int val) {
  * and loads that label address into the register.
  */
 void Mips::EmitLoadStringConstant(Location *dst, const char *str) {
-    static int strNum = 1;
-    char label[16];
-    sprintf(label, "_string%d", strNum++);
+    char label[48];
+    sprintf(label, "_%sstring%d", ctx->labelPrefix, ctx->nextStrNum++);
     Emit(".data\t\t\t# create string constant marked with label");
     Emit("%s: .asciiz %s", label, str);
     Emit(".text");
@@ -217,6 +205,12 @@ void Mips::EmitIfZ(Location *test, const char *label) {
             test->GetName());
 }
 
+void Mips::EmitIfNZ(Location *test, const char *label) {
+    FillRegister(test, rs);
+    Emit("bnez %s, %s\t# branch if %s is not zero ", regs[rs].name, label,
+            test->GetName());
+}
+
 /* Method: EmitParam
  * -----------------
  * Used to push a parameter on the stack in anticipation of upcoming
@@ -335,17 +329,58 @@ void Mips::EmitEndFunction() {
  * ------------------
  * Used to layout a vtable. Uses assembly directives to set up new
  * entry in data segment, emits label, and lays out the function
- * labels one after another.
+ * labels one after another. The interface tables of the class are laid
+ * out below the label in reverse order, so that the table of interface n
+ * is at offset -4 * (n + 1) from the vtable.
  */
-void Mips::EmitVTable(const char *label, List<const char*> *methodLabels) {
+void Mips::EmitVTable(const char *label, List<const char*> *methodLabels,
+        List<const char*> *itableLabels) {
     Emit(".data");
     Emit(".align 2");
+    if (itableLabels) {
+        for (int i = itableLabels->NumElements() - 1; i >= 0; i--) {
+            if (itableLabels->Nth(i))
+                Emit(".word %s\t# interface %d", itableLabels->Nth(i), i);
+            else
+                Emit(".word 0\t# interface %d", i);
+        }
+    }
     Emit("%s:\t\t# label for class %s vtable", label, label);
     for (int i = 0; i < methodLabels->NumElements(); i++)
         Emit(".word %s\n", methodLabels->Nth(i));
     Emit(".text");
 }
 
+/* Method: EmitITable
+ * ------------------
+ * Used to layout the table of a class for one interface, the function
+ * labels are in the order of the interface's methods.
+ */
+void Mips::EmitITable(const char *label, List<const char*> *methodLabels) {
+    Emit(".data");
+    Emit(".align 2");
+    Emit("%s:\t\t# label for interface table %s", label, label);
+    for (int i = 0; i < methodLabels->NumElements(); i++)
+        Emit(".word %s\n", methodLabels->Nth(i));
+    Emit(".text");
+}
+
+/* Method: EmitProfileTable
+ * ------------------------
+ * Used to layout the profile counters of a function, after its name and
+ * their number, see CodeGenerator::Instrument.
+ */
+void Mips::EmitProfileTable(const char *label, const char *function,
+        int numCounters) {
+    Emit(".data");
+    Emit("%s.name: .asciiz \"%s\"", label, function);
+    Emit(".align 2");
+    Emit("%s:\t\t# label for profile table of %s", label, function);
+    Emit(".word %s.name, %d", label, numCounters);
+    Emit(".space %d", 4 * numCounters);
+    Emit(".text");
+}
+
 /* Method: EmitPreamble
  * --------------------
  * Used to emit the starting sequence needed for a program. Not much
@@ -374,23 +409,10 @@ const char *Mips::NameForTac(BinaryOp::OpCode code) {
 
 /* Constructor
  * ----------
- * Constructor sets up the mips names and register descriptors to
- * the initial starting state.
+ * Constructor sets up the register descriptors to the initial starting
+ * state.
  */
 Mips::Mips() {
-    mipsName[BinaryOp::Add] = "add";
-    mipsName[BinaryOp::Sub] = "sub";
-    mipsName[BinaryOp::Mul] = "mul";
-    mipsName[BinaryOp::Div] = "div";
-    mipsName[BinaryOp::Mod] = "rem";
-    mipsName[BinaryOp::Eq] = "seq";
-    mipsName[BinaryOp::Ne] = "sne";
-    mipsName[BinaryOp::Lt] = "slt";
-    mipsName[BinaryOp::Le] = "sle";
-    mipsName[BinaryOp::Gt] = "sgt";
-    mipsName[BinaryOp::Ge] = "sge";
-    mipsName[BinaryOp::And] = "and";
-    mipsName[BinaryOp::Or] = "or";
     regs[zero] = (RegContents){false, NULL, "$zero", false};
     regs[at] = (RegContents){false, NULL, "$at", false};
     regs[v0] = (RegContents){false, NULL, "$v0", false};
@@ -426,5 +448,13 @@ Mips::Mips() {
     rs = t0; rt = t1; rd = t2;
 }
 
-const char *Mips::mipsName[BinaryOp::NumOps];
+/* The mips names of the tac binary operators, in the order of OpCode.
+ * The table is constant, since all the compilations in the process
+ * share it.
+ */
+const char * const Mips::mipsName[BinaryOp::NumOps] = {
+    "add", "sub", "mul", "div", "rem",
+    "seq", "sne", "slt", "sle", "sgt", "sge",
+    "and", "or"
+};
 
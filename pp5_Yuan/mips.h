@@ -19,11 +19,12 @@
 #define _H_mips
 
 #include "tac.h"
+#include "target.h"
 #include "list.h"
 
 class Location;
 
-class Mips
+class Mips : public Target
 {
   private:
     typedef enum {
@@ -49,15 +50,13 @@ class Mips
 
     void EmitCallInstr(Location *dst, const char *fn, bool isL);
 
-    static const char *mipsName[BinaryOp::NumOps];
+    static const char * const mipsName[BinaryOp::NumOps];
     static const char *NameForTac(BinaryOp::OpCode code);
 
-    Instruction* currentInstruction;
-
  public:
     Mips();
 
-    static void Emit(const char *fmt, ...);
+    void EmitComment(const char *tac);
 
     void EmitLoadConstant(Location *dst, int val);
     void EmitLoadStringConstant(Location *dst, const char *str);
@@ -73,6 +72,7 @@ class Mips
     void EmitLabel(const char *label);
     void EmitGoto(const char *label);
     void EmitIfZ(Location *test, const char*label);
+    void EmitIfNZ(Location *test, const char*label);
     void EmitReturn(Location *returnVal);
 
     void EmitBeginFunction(int frameSize);
@@ -83,27 +83,13 @@ class Mips
     void EmitACall(Location *result, Location *fnAddr);
     void EmitPopParams(int bytes);
 
-    void EmitVTable(const char *label, List<const char*> *methodLabels);
+    void EmitVTable(const char *label, List<const char*> *methodLabels,
+                    List<const char*> *itableLabels = NULL);
+    void EmitITable(const char *label, List<const char*> *methodLabels);
+    void EmitProfileTable(const char *label, const char *function,
+                          int numCounters);
 
     void EmitPreamble();
-
-    class CurrentInstruction;
-};
-
-// Adds CurrentInstruction to the Mips object
-class Mips::CurrentInstruction
-{
-  public:
-    CurrentInstruction(Mips& mips, Instruction* instr) : mips( mips ) {
-        mips.currentInstruction= instr;
-    }
-
-    ~CurrentInstruction() {
-        mips.currentInstruction= NULL;
-    }
-
-  private:
-    Mips& mips;
 };
 
 #endif
@@ -0,0 +1,589 @@
+/* File: mipssim.cc
+ * ----------------
+ * Implementation of the MipsSim.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "mipssim.h"
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+// the machine, as in interp.cc: the data segment and the heap grow up
+// from DataBase, the stack grows down from the end of the memory.
+static const uint32_t MemorySize = 64 << 20;
+static const uint32_t StackSize = 8 << 20;
+
+static const char * const regNames[32] = {
+    "zero", "at", "v0", "v1", "a0", "a1", "a2", "a3",
+    "t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7",
+    "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+    "t8", "t9", "k0", "k1", "gp", "sp", "fp", "ra"
+};
+enum { Zero = 0, V0 = 2, A0 = 4, A1 = 5, Gp = 28, Sp = 29, Ra = 31 };
+
+// gp is set as by spim, the global vars are within 32 KB above it, below
+// the heap.
+static const uint32_t GpValue = 0x10008000, GlobalsEnd = 0x10010000;
+
+// the instructions with their operands: r a register, i an immediate,
+// m a memory operand, l a label, and A for the arithmetic, whose last
+// operand is a register or an immediate, and may be left out.
+static const struct {
+    const char *name;
+    MipsSim::OpCode code;
+    const char *operands;
+} instructions[] = {
+    { "li", MipsSim::I_Li, "ri" },
+    { "la", MipsSim::I_La, "rl" },
+    { "move", MipsSim::I_Move, "rr" },
+    { "lw", MipsSim::I_Lw, "rm" },
+    { "lb", MipsSim::I_Lb, "rm" },
+    { "sw", MipsSim::I_Sw, "rm" },
+    { "sb", MipsSim::I_Sb, "rm" },
+    { "add", MipsSim::I_Add, "A" },
+    { "addu", MipsSim::I_Add, "A" },
+    { "addi", MipsSim::I_Add, "A" },
+    { "addiu", MipsSim::I_Add, "A" },
+    { "sub", MipsSim::I_Sub, "A" },
+    { "subu", MipsSim::I_Sub, "A" },
+    { "mul", MipsSim::I_Mul, "A" },
+    { "div", MipsSim::I_Div, "A" },
+    { "rem", MipsSim::I_Rem, "A" },
+    { "seq", MipsSim::I_Seq, "A" },
+    { "sne", MipsSim::I_Sne, "A" },
+    { "slt", MipsSim::I_Slt, "A" },
+    { "sle", MipsSim::I_Sle, "A" },
+    { "sgt", MipsSim::I_Sgt, "A" },
+    { "sge", MipsSim::I_Sge, "A" },
+    { "and", MipsSim::I_And, "A" },
+    { "andi", MipsSim::I_And, "A" },
+    { "or", MipsSim::I_Or, "A" },
+    { "ori", MipsSim::I_Or, "A" },
+    { "b", MipsSim::I_B, "l" },
+    { "beqz", MipsSim::I_Beqz, "rl" },
+    { "bnez", MipsSim::I_Bnez, "rl" },
+    { "bne", MipsSim::I_Bne, "rAl" },
+    { "blez", MipsSim::I_Blez, "rl" },
+    { "jal", MipsSim::I_Jal, "l" },
+    { "jalr", MipsSim::I_Jalr, "r" },
+    { "jr", MipsSim::I_Jr, "r" },
+    { "syscall", MipsSim::I_Syscall, "" },
+};
+
+static bool ParseReg(const std::string &s, uint8_t *r) {
+    if (s.size() < 2 || s[0] != '$') return false;
+    const char *name = s.c_str() + 1;
+    if (isdigit(*name)) {
+        char *end;
+        long n = strtol(name, &end, 10);
+        if (*end || n < 0 || n > 31) return false;
+        *r = n;
+        return true;
+    }
+    for (int i = 0; i < 32; i++) {
+        if (!strcmp(name, regNames[i])) {
+            *r = i;
+            return true;
+        }
+    }
+    if (!strcmp(name, "s8")) {
+        *r = 30;
+        return true;
+    }
+    return false;
+}
+
+static bool ParseInt(const std::string &s, int32_t *n) {
+    if (s.empty() || !(isdigit(s[0]) || s[0] == '-' || s[0] == '+'))
+        return false;
+    char *end;
+    long long v = strtoll(s.c_str(), &end, 0);
+    if (*end) return false;
+    *n = (int32_t)v;
+    return true;
+}
+
+static bool IsLabelChar(char c) {
+    return isalnum(c) || c == '_' || c == '.' || c == '$';
+}
+
+MipsSim::MipsSim(FILE *o, std::ostream *e) {
+    memset(regs, 0, sizeof(regs));
+    mem = NULL;
+    memSize = heap = stackLimit = 0;
+    maxInsts = 0;
+    out = o;
+    err = e;
+}
+
+MipsSim::~MipsSim() {
+    free(mem);
+}
+
+bool MipsSim::Error(const char *file, int line, const char *format, ...) {
+    va_list args;
+    char buf[256];
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    *err << "*** " << file << ":" << line << ": " << buf << std::endl;
+    return false;
+}
+
+int MipsSim::RuntimeError(const char *format, ...) {
+    va_list args;
+    char buf[256];
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    fflush(out);
+    *err << "*** Runtime error: " << buf << std::endl;
+    return 1;
+}
+
+bool MipsSim::Assemble(const char *source, const char *file) {
+    bool inText = true;
+    int n = 1;
+    for (const char *p = source; *p; n++) {
+        const char *end = strchr(p, '\n');
+        if (!end) end = p + strlen(p);
+        std::string line(p, end);
+        if (!AssembleLine(&line[0], &inText, file, n)) return false;
+        p = *end ? end + 1 : end;
+    }
+    return true;
+}
+
+/*
+ * Assembles one line: labels, then a directive or an instruction. The
+ * operands are separated by commas or spaces.
+ */
+bool MipsSim::AssembleLine(char *line, bool *inText, const char *file,
+                           int n) {
+    // cut the comment, outside of the strings.
+    bool quoted = false;
+    for (char *p = line; *p; p++) {
+        if (quoted && *p == '\\' && p[1]) p++;
+        else if (*p == '"') quoted = !quoted;
+        else if (!quoted && *p == '#') { *p = '\0'; break; }
+    }
+
+    char *p = line;
+    for (;;) {
+        while (isspace(*p)) p++;
+        char *q = p;
+        while (IsLabelChar(*q)) q++;
+        if (q == p || *q != ':') break;
+        std::string label(p, q);
+        if (labels.count(label))
+            return Error(file, n, "Label %s is defined twice.", label.c_str());
+        labels[label] = *inText ? TextBase + 4 * text.size()
+                                : DataBase + data.size();
+        p = q + 1;
+    }
+    if (!*p) return true;
+
+    char *q = p;
+    while (*q && !isspace(*q)) q++;
+    std::string name(p, q);
+    p = q;
+    while (isspace(*p)) p++;
+
+    if (name[0] == '.') {
+        if (name == ".text") {
+            *inText = true;
+        } else if (name == ".data") {
+            *inText = false;
+        } else if (name == ".globl") {
+        } else if (name == ".align") {
+            int32_t a;
+            if (!ParseInt(p, &a) || a < 0 || a > 12)
+                return Error(file, n, "Bad alignment.");
+            if (!*inText)
+                data.resize((data.size() + (1 << a) - 1) & ~((1 << a) - 1));
+        } else if (*inText) {
+            return Error(file, n, "Data in the text segment.");
+        } else if (name == ".asciiz") {
+            // the escapes of spim, as in Interpreter.
+            int len = strlen(p);
+            while (len > 0 && isspace(p[len - 1])) len--;
+            if (len < 2 || p[0] != '"' || p[len - 1] != '"')
+                return Error(file, n, "Bad string.");
+            for (int i = 1; i < len - 1; i++) {
+                char c = p[i];
+                if (c == '\\' && i + 1 < len - 1) {
+                    switch (p[++i]) {
+                      case 'n': c = '\n'; break;
+                      case 't': c = '\t'; break;
+                      case '"': c = '"'; break;
+                      case '\\': c = '\\'; break;
+                      default: data.push_back('\\'); c = p[i]; break;
+                    }
+                }
+                data.push_back(c);
+            }
+            data.push_back('\0');
+        } else if (name == ".word") {
+            for (char *w = strtok(p, ", \t\r"); w; w = strtok(NULL, ", \t\r")) {
+                int32_t v = 0;
+                if (!ParseInt(w, &v)) {
+                    Fixup f = { (int)data.size(), w, true, n, file };
+                    fixups.push_back(f);
+                }
+                data.resize(data.size() + 4);
+                memcpy(&data[data.size() - 4], &v, 4);
+            }
+        } else if (name == ".space") {
+            int32_t size;
+            if (!ParseInt(p, &size) || size < 0)
+                return Error(file, n, "Bad size.");
+            data.resize(data.size() + size);
+        } else {
+            return Error(file, n, "Unknown directive %s.", name.c_str());
+        }
+        return true;
+    }
+
+    if (!*inText) return Error(file, n, "Instruction in the data segment.");
+    std::vector<std::string> args;
+    for (char *w = strtok(p, ", \t\r"); w; w = strtok(NULL, ", \t\r"))
+        args.push_back(w);
+
+    int k = 0, numInsts = sizeof(instructions) / sizeof(instructions[0]);
+    while (k < numInsts && name != instructions[k].name) k++;
+    if (k == numInsts)
+        return Error(file, n, "Unknown instruction %s.", name.c_str());
+    Inst inst;
+    memset(&inst, 0, sizeof(inst));
+    inst.code = instructions[k].code;
+
+    // an arithmetic instruction with two operands is rd, rd, op.
+    const char *operands = instructions[k].operands;
+    if (!strcmp(operands, "A"))
+        operands = args.size() == 2 ? "rA" : "rrA";
+    if (args.size() != strlen(operands))
+        return Error(file, n, "Bad operands of %s.", name.c_str());
+    uint8_t *reg[2] = { &inst.rd, &inst.rs };
+    if (!strcmp(operands, "rA") || !strcmp(operands, "rAl")) {
+        reg[1] = &inst.rt;
+        if (inst.code != I_Bne) inst.rs = 0xff;
+    }
+    int r = 0;
+    for (int i = 0; operands[i]; i++) {
+        const std::string &a = args[i];
+        switch (operands[i]) {
+          case 'r':
+            if (!ParseReg(a, reg[r++]))
+                return Error(file, n, "Bad register %s.", a.c_str());
+            break;
+          case 'i':
+            if (!ParseInt(a, &inst.imm))
+                return Error(file, n, "Bad immediate %s.", a.c_str());
+            break;
+          case 'A':
+            if (ParseInt(a, &inst.imm)) inst.isImm = true;
+            else if (!ParseReg(a, &inst.rt))
+                return Error(file, n, "Bad operand %s.", a.c_str());
+            break;
+          case 'l': {
+            Fixup f = { (int)text.size(), a, false, n, file };
+            fixups.push_back(f);
+            break;
+          }
+          case 'm': {
+            // off(reg), (reg) or a label.
+            size_t open = a.find('(');
+            if (open == std::string::npos) {
+                Fixup f = { (int)text.size(), a, false, n, file };
+                fixups.push_back(f);
+                inst.rs = Zero;
+            } else if (a[a.size() - 1] != ')' ||
+                       !ParseReg(a.substr(open + 1, a.size() - open - 2),
+                                 &inst.rs) ||
+                       (open > 0 && !ParseInt(a.substr(0, open), &inst.imm))) {
+                return Error(file, n, "Bad address %s.", a.c_str());
+            }
+            break;
+          }
+        }
+    }
+    if (inst.rs == 0xff) inst.rs = inst.rd;
+    text.push_back(inst);
+    return true;
+}
+
+bool MipsSim::Link() {
+    bool ok = true;
+    uint32_t textEnd = TextBase + 4 * text.size();
+    for (size_t i = 0; i < fixups.size(); i++) {
+        const Fixup &f = fixups[i];
+        std::map<std::string, uint32_t>::iterator l = labels.find(f.label);
+        if (l == labels.end()) {
+            ok = Error(f.file.c_str(), f.line, "Undefined label %s.",
+                       f.label.c_str());
+            continue;
+        }
+        uint32_t addr = l->second;
+        if (f.isData) {
+            memcpy(&data[f.index], &addr, 4);
+            continue;
+        }
+        Inst &inst = text[f.index];
+        if (inst.code >= I_B && inst.code <= I_Jal &&
+            (addr < TextBase || addr >= textEnd)) {
+            ok = Error(f.file.c_str(), f.line, "%s is not a code label.",
+                       f.label.c_str());
+        }
+        inst.imm = addr;
+    }
+    fixups.clear();
+    return ok;
+}
+
+/*
+ * The counts of the function entered at addr, made when it is first
+ * called. It is named after a label at addr.
+ */
+int MipsSim::FunctionAt(uint32_t addr) {
+    int index = (addr - TextBase) / 4;
+    if (fnAt[index] < 0) {
+        Counts c = { "?", 0, 0, 0, 0 };
+        std::map<std::string, uint32_t>::iterator l;
+        for (l = labels.begin(); l != labels.end(); ++l) {
+            if (l->second == addr) {
+                c.name = l->first;
+                break;
+            }
+        }
+        fnAt[index] = counts.size();
+        counts.push_back(c);
+    }
+    return fnAt[index];
+}
+
+/*
+ * The syscalls of defs.asm, with the number in $v0 and the arguments in
+ * $a0 and $a1.
+ */
+bool MipsSim::Syscall(bool *exit) {
+    uint32_t a0 = regs[A0];
+    switch (regs[V0]) {
+      case 1:                       // print_int
+        fprintf(out, "%d", (int32_t)a0);
+        return true;
+      case 4: {                     // print_string
+        if (!Valid(a0, 1) || !memchr(mem + (a0 - DataBase), '\0',
+                                     memSize - (a0 - DataBase))) {
+            RuntimeError("Bad string address 0x%08x in print_string.", a0);
+            return false;
+        }
+        fputs(mem + (a0 - DataBase), out);
+        return true;
+      }
+      case 5: {                     // read_int
+        char line[64];
+        fflush(out);
+        regs[V0] = fgets(line, sizeof(line), stdin) ? atoi(line) : 0;
+        return true;
+      }
+      case 8: {                     // read_string
+        int32_t size = regs[A1];
+        if (size < 1) return true;
+        if (!Valid(a0, size)) {
+            RuntimeError("Bad address 0x%08x in read_string.", a0);
+            return false;
+        }
+        char *buf = mem + (a0 - DataBase);
+        fflush(out);
+        if (!fgets(buf, size, stdin)) *buf = '\0';
+        return true;
+      }
+      case 9: {                     // sbrk
+        uint32_t size = (a0 + 3) & ~3;
+        if ((int32_t)a0 < 0 || size > stackLimit - heap) {
+            RuntimeError("Out of memory, cannot allocate %d bytes.", a0);
+            return false;
+        }
+        regs[V0] = heap;
+        heap += size;
+        return true;
+      }
+      case 10:                      // exit
+        *exit = true;
+        return true;
+      default:
+        RuntimeError("Unknown syscall %d.", regs[V0]);
+        return false;
+    }
+}
+
+int MipsSim::Run() {
+    if (!labels.count("main") || labels["main"] < TextBase ||
+        labels["main"] >= TextBase + 4 * text.size())
+        return RuntimeError("There is no main function.");
+
+    // lay out the data, the globals and the heap, the stack is at the end.
+    memSize = MemorySize;
+    stackLimit = DataBase + memSize - StackSize;
+    if (data.size() > stackLimit - DataBase)
+        return RuntimeError("The program does not fit in memory.");
+    mem = (char *)calloc(memSize, 1);
+    if (!mem) return RuntimeError("Cannot allocate the memory.");
+    if (!data.empty()) memcpy(mem, &data[0], data.size());
+    heap = std::max(DataBase + (uint32_t)((data.size() + 7) & ~7),
+                    GlobalsEnd);
+
+    // main is called from the startup code, which exits when it returns.
+    const uint32_t numInsts = text.size(), exitAddr = TextBase + 4 * numInsts;
+    regs[Gp] = GpValue;
+    regs[Sp] = DataBase + memSize - 8;
+    regs[Ra] = exitAddr;
+    fnAt.assign(numInsts, -1);
+    counts.clear();
+    std::vector<int> callers;
+    int fn = FunctionAt(labels["main"]);
+    counts[fn].calls++;
+    uint32_t pc = (labels["main"] - TextBase) / 4;
+    uint64_t executed = 0;
+
+    for (;;) {
+        const Inst &inst = text[pc++];
+        Counts &c = counts[fn];
+        c.insts++;
+        if (++executed == maxInsts)
+            return RuntimeError("The program ran %llu instructions.",
+                                (unsigned long long)maxInsts);
+        int32_t y = inst.isImm ? inst.imm : regs[inst.rt];
+        uint32_t addr = regs[inst.rs] + inst.imm, target = 0;
+        switch (inst.code) {
+          case I_Li:
+          case I_La: regs[inst.rd] = inst.imm; break;
+          case I_Move: regs[inst.rd] = regs[inst.rs]; break;
+          case I_Lw:
+            c.loads++;
+            if (!Valid(addr, 4) || addr % 4)
+                return RuntimeError("Bad address 0x%08x in load.", addr);
+            memcpy(&regs[inst.rd], mem + (addr - DataBase), 4);
+            break;
+          case I_Lb:
+            c.loads++;
+            if (!Valid(addr, 1))
+                return RuntimeError("Bad address 0x%08x in load.", addr);
+            regs[inst.rd] = (signed char)mem[addr - DataBase];
+            break;
+          case I_Sw:
+            c.stores++;
+            if (!Valid(addr, 4) || addr % 4)
+                return RuntimeError("Bad address 0x%08x in store.", addr);
+            memcpy(mem + (addr - DataBase), &regs[inst.rd], 4);
+            break;
+          case I_Sb:
+            c.stores++;
+            if (!Valid(addr, 1))
+                return RuntimeError("Bad address 0x%08x in store.", addr);
+            mem[addr - DataBase] = regs[inst.rd];
+            break;
+          case I_Add: regs[inst.rd] = (uint32_t)regs[inst.rs] + y; break;
+          case I_Sub: regs[inst.rd] = (uint32_t)regs[inst.rs] - y; break;
+          case I_Mul: regs[inst.rd] = (uint32_t)regs[inst.rs] * y; break;
+          case I_Div:
+            if (y == 0) return RuntimeError("Division by zero.");
+            regs[inst.rd] = y == -1 ? -(uint32_t)regs[inst.rs]
+                                    : regs[inst.rs] / y;
+            break;
+          case I_Rem:
+            if (y == 0) return RuntimeError("Division by zero.");
+            regs[inst.rd] = y == -1 ? 0 : regs[inst.rs] % y;
+            break;
+          case I_Seq: regs[inst.rd] = regs[inst.rs] == y; break;
+          case I_Sne: regs[inst.rd] = regs[inst.rs] != y; break;
+          case I_Slt: regs[inst.rd] = regs[inst.rs] < y; break;
+          case I_Sle: regs[inst.rd] = regs[inst.rs] <= y; break;
+          case I_Sgt: regs[inst.rd] = regs[inst.rs] > y; break;
+          case I_Sge: regs[inst.rd] = regs[inst.rs] >= y; break;
+          case I_And: regs[inst.rd] = regs[inst.rs] & y; break;
+          case I_Or: regs[inst.rd] = regs[inst.rs] | y; break;
+          case I_B: pc = (inst.imm - TextBase) / 4; break;
+          case I_Beqz:
+            if (regs[inst.rd] == 0) pc = (inst.imm - TextBase) / 4;
+            break;
+          case I_Bnez:
+            if (regs[inst.rd] != 0) pc = (inst.imm - TextBase) / 4;
+            break;
+          case I_Bne:
+            if (regs[inst.rd] != y) pc = (inst.imm - TextBase) / 4;
+            break;
+          case I_Blez:
+            if (regs[inst.rd] <= 0) pc = (inst.imm - TextBase) / 4;
+            break;
+          case I_Jal:
+          case I_Jalr:
+            target = inst.code == I_Jal ? inst.imm : regs[inst.rd];
+            if (target - TextBase >= 4 * numInsts || target % 4)
+                return RuntimeError("Bad address 0x%08x in call.", target);
+            regs[Ra] = TextBase + 4 * pc;
+            callers.push_back(fn);
+            fn = FunctionAt(target);
+            counts[fn].calls++;
+            pc = (target - TextBase) / 4;
+            break;
+          case I_Jr:
+            target = regs[inst.rd];
+            if (target == exitAddr) return 0;
+            if (target - TextBase >= 4 * numInsts || target % 4)
+                return RuntimeError("Bad address 0x%08x in jump.", target);
+            if (!callers.empty()) {
+                fn = callers.back();
+                callers.pop_back();
+            }
+            pc = (target - TextBase) / 4;
+            break;
+          case I_Syscall: {
+            bool exit = false;
+            if (!Syscall(&exit)) return 1;
+            if (exit) return 0;
+            break;
+          }
+        }
+        regs[Zero] = 0;
+        if ((uint32_t)regs[Sp] < stackLimit)
+            return RuntimeError("Stack overflow.");
+        if (pc >= numInsts)
+            return RuntimeError("The program runs past the end of the text.");
+    }
+}
+
+static bool ByInsts(const MipsSim::Counts &a, const MipsSim::Counts &b) {
+    return a.insts > b.insts;
+}
+
+void MipsSim::PrintCounts(std::ostream &os) {
+    std::vector<Counts> sorted(counts);
+    std::stable_sort(sorted.begin(), sorted.end(), ByInsts);
+    Counts total = { "total", 0, 0, 0, 0 };
+    char line[256];
+    snprintf(line, sizeof(line), "%-32s %10s %14s %12s %12s\n",
+             "function", "calls", "insts", "loads", "stores");
+    os << line;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        const Counts &c = sorted[i];
+        snprintf(line, sizeof(line), "%-32s %10llu %14llu %12llu %12llu\n",
+                 c.name.c_str(), (unsigned long long)c.calls,
+                 (unsigned long long)c.insts, (unsigned long long)c.loads,
+                 (unsigned long long)c.stores);
+        os << line;
+        total.calls += c.calls;
+        total.insts += c.insts;
+        total.loads += c.loads;
+        total.stores += c.stores;
+    }
+    snprintf(line, sizeof(line), "%-32s %10llu %14llu %12llu %12llu\n",
+             total.name.c_str(), (unsigned long long)total.calls,
+             (unsigned long long)total.insts, (unsigned long long)total.loads,
+             (unsigned long long)total.stores);
+    os << line;
+}
@@ -0,0 +1,134 @@
+/* File: mipssim.h
+ * ---------------
+ * The MipsSim class runs the MIPS assembly of dcc without spim, for the
+ * test scripts and for measuring the generated code:
+ *
+ *    dcc-sim [--counts] [--limit <insts>] <prog.decaf | prog.asm> ...
+ *
+ * A .decaf file is compiled in the process and its assembly is loaded
+ * from memory, an .asm file is loaded as it is. defs.asm is loaded from
+ * the directory of dcc-sim if the files do not define the built-in
+ * functions. The program starts at main and stops when main returns or
+ * at the exit syscall, as with the startup code of trap.handler.
+ *
+ * The simulator knows the subset of MIPS32 that the Mips class and
+ * defs.asm use: the directives .text, .data, .align, .asciiz, .word and
+ * .globl, the loads, stores, moves, arithmetic and compares, the branches
+ * and jumps, and the syscalls print_int, print_string, read_int,
+ * read_string, sbrk and exit. The pseudo instructions of spim (li, la,
+ * mul, div, rem, seq, ...) are executed as one instruction each. The
+ * memory is the one of spim: the text at 0x00400000, the data and the
+ * heap growing up from 0x10000000, the stack growing down. A bad or
+ * misaligned address, a division by zero, a jump out of the text and a
+ * stack overflow stop the program with a runtime error, where spim
+ * would go to the trap handler.
+ *
+ * With --counts, the instructions, loads and stores executed are counted
+ * per function, with the number of calls to it, and printed on stderr
+ * after the run. A function is the code reached by a jal or jalr, until
+ * its jr, so the counts of a function do not include its callees. The
+ * counts are deterministic, they measure the cost of the generated code.
+ * With --limit, a program which runs more instructions is stopped with a
+ * runtime error, such as one waiting for input at the end of its input.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_mipssim
+#define _H_mipssim
+
+#include <stdint.h>
+#include <stdio.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+class MipsSim
+{
+  public:
+    typedef enum {
+        I_Li, I_La, I_Move, I_Lw, I_Lb, I_Sw, I_Sb,
+        I_Add, I_Sub, I_Mul, I_Div, I_Rem,
+        I_Seq, I_Sne, I_Slt, I_Sle, I_Sgt, I_Sge, I_And, I_Or,
+        I_B, I_Beqz, I_Bnez, I_Bne, I_Blez, I_Jal, I_Jalr, I_Jr, I_Syscall
+    } OpCode;
+
+    struct Inst {
+        uint8_t code;               // OpCode.
+        uint8_t rd, rs, rt;         // registers.
+        bool isImm;                 // the second operand is imm, not rt.
+        int32_t imm;                // an immediate, an offset or an
+                                    // address.
+    };
+
+    // the counts of a function, see above.
+    struct Counts {
+        std::string name;
+        uint64_t calls, insts, loads, stores;
+    };
+
+    static const uint32_t TextBase = 0x00400000, DataBase = 0x10000000;
+
+  protected:
+    // a label used by an instruction or a .word, patched by Link.
+    struct Fixup {
+        int index;                  // of the instruction or data byte.
+        std::string label;
+        bool isData;
+        int line;
+        std::string file;
+    };
+
+    std::vector<Inst> text;
+    std::vector<char> data;
+    std::map<std::string, uint32_t> labels;
+    std::vector<Fixup> fixups;
+    std::vector<Counts> counts;
+    std::vector<int> fnAt;          // the counts of the function entered
+                                    // at each instruction, or -1.
+
+    // the machine.
+    int32_t regs[32];
+    char *mem;
+    uint32_t memSize, heap, stackLimit;
+    uint64_t maxInsts;              // the limit of the run, or 0.
+    FILE *out;
+    std::ostream *err;
+
+    bool AssembleLine(char *line, bool *inText, const char *file, int n);
+    bool Error(const char *file, int line, const char *format, ...);
+    int RuntimeError(const char *format, ...);
+    int FunctionAt(uint32_t addr);
+    bool Syscall(bool *exit);
+
+    bool Valid(uint32_t addr, uint32_t size) {
+        return addr - DataBase < memSize && size <= memSize -
+               (addr - DataBase);
+    }
+
+  public:
+    MipsSim(FILE *out, std::ostream *err);
+    ~MipsSim();
+
+    // assembles the text of an assembly file, returns false after an
+    // error, reported with the given file name.
+    bool Assemble(const char *text, const char *file);
+    // returns true if the label is defined.
+    bool IsDefined(const char *label) { return labels.count(label) > 0; }
+    // resolves the labels, returns false if some label is not defined.
+    bool Link();
+
+    // stops the runs after the given number of instructions, 0 for none.
+    void SetLimit(uint64_t insts) { maxInsts = insts; }
+
+    // runs the program from main, with the given input and output, and
+    // returns its exit status: 0 when main returns or the program exits,
+    // 1 after a runtime error.
+    int Run();
+
+    // prints the counts of the functions, the busiest first.
+    void PrintCounts(std::ostream &os);
+};
+
+#endif
@@ -31,8 +31,9 @@
 #include "y.tab.h"
 #endif
 
-int yyparse();              // Defined in the generated y.tab.c file
+int yyparse(void *scanner); // Defined in the generated y.tab.c file
 void InitParser();          // Defined in parser.y
+void EndParser();           // Defined in parser.y
 
 #endif
 
@@ -34,11 +34,49 @@
 #include "scanner.h" // for yylex
 #include "parser.h"
 #include "errors.h"
+#include "trace.h"
 
-void yyerror(const char *msg); // standard error-handling routine
+// standard error-handling routine, gets the location of the lookahead.
+void yyerror(yyltype *loc, void *scanner, const char *msg);
 
 %}
 
+/* The parser is pure: the lookahead value and location are locals of
+ * yyparse, and both the scanner and the parser get the reentrant scanner
+ * of the current compilation, so each thread can run its own compilation.
+ */
+%define api.pure full
+%locations
+%parse-param {void *scanner}
+%lex-param {void *scanner}
+
+%code provides {
+int yylex(YYSTYPE *yylval, YYLTYPE *yylloc, void *scanner);
+}
+
+/* For --time-report, the time in the scanner is taken from the parse.
+ */
+%code {
+#include "context.h"
+#include "stats.h"
+
+// the time spent in the scanner, moved to its phase by EndParser.
+static thread_local Stats::Sample scanned;
+
+static int TimedLex(YYSTYPE *yylval, YYLTYPE *yylloc, void *scanner) {
+    if (!ctx->stats) return yylex(yylval, yylloc, scanner);
+    Stats::Sample start = Stats::Now();
+    int token = yylex(yylval, yylloc, scanner);
+    Stats::Sample end = Stats::Now();
+    scanned.wall += end.wall - start.wall;
+    scanned.cpu += end.cpu - start.cpu;
+    scanned.alloc += end.alloc - start.alloc;
+    ctx->stats->Increment(Stats::Tokens, 1);
+    return token;
+}
+#define yylex TimedLex
+}
+
 /* The section before the first %% is the Definitions section of the yacc
  * input file. Here is where you declare tokens and types, add precedence
  * and associativity options, and so on.
@@ -56,7 +94,7 @@ void yyerror(const char *msg); // standard error-handling routine
 %union {
     int integerConstant;
     bool boolConstant;
-    char *stringConstant;
+    TokenView stringConstant;
     double doubleConstant;
     char identifier[MaxIdentLen+1]; // +1 for terminating null
 
@@ -178,13 +216,10 @@ void yyerror(const char *msg); // standard error-handling routine
  */
 
 Program   :    DeclList            {
-                                      @1;
-                                      /* pp2: The @1 is needed to convince
-                                       * yacc to set up yylloc. You can remove
-                                       * it once you have other uses of @n */
                                       Program *program = new Program($1);
                                       // if no errors, advance to next phase
-
+                                      if (ReportError::NumErrors() == 0)
+                                          program->Check();
                                       if (ReportError::NumErrors() == 0)
                                           program->Emit();
                                     }
@@ -222,7 +257,7 @@ Type      :    T_Int                { $$ = Type::intType; }
           |    Type T_Dims          { $$ = new ArrayType(Join(@1, @2), $1); }
 ;
 
-FnDecl    :    FnHeader StmtBlock   { ($$=$1)->SetFunctionBody($2); }
+FnDecl    :    FnHeader StmtBlock   { ($$=$1)->SetFunctionBody($2, @2); }
 ;
 
 FnHeader  :    Type T_Identifier '(' Formals ')'
@@ -500,7 +535,8 @@ Actuals   :    ExprPlus             { $$ = $1; }
 Constant  :    T_IntConstant        { $$ = new IntConstant(@1, $1); }
           |    T_DoubleConstant     { $$ = new DoubleConstant(@1, $1); }
           |    T_BoolConstant       { $$ = new BoolConstant(@1, $1); }
-          |    T_StringConstant     { $$ = new StringConstant(@1, $1); }
+          |    T_StringConstant     { $$ = new StringConstant(@1, $1.text,
+                                                            $1.length); }
           |    T_Null               { $$ = new NullConstant(@1); }
 ;
 
@@ -527,7 +563,20 @@ Constant  :    T_IntConstant        { $$ = new IntConstant(@1, $1); }
  */
 void InitParser()
 {
-    PrintDebug("parser", "Initializing parser");
-    yydebug = false;
+    Trace(T_Parser, "Initializing parser");
+    // yydebug is shared by all the compilations in the process, so it is
+    // only written when it is on.
+    if (yydebug) yydebug = false;
+    scanned = Stats::Sample();
+}
+
+/* Function: EndParser
+ * -------------------
+ * Called after yyparse(), it moves the time the scanner took from the
+ * parse to the scan phase of the Stats, once rather than per token.
+ */
+void EndParser()
+{
+    if (ctx->stats) ctx->stats->SplitPhase("parse", "scan", scanned);
 }
 
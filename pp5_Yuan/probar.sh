@@ -62,3 +62,190 @@ echo "\n\n\n"
 echo "-----------------------18--------------------------------"
 ./run samples/t8.decaf
 
+echo "\n\n\n"
+echo "-----------------------19--------------------------------"
+./run samples/interface.decaf
+
+echo "\n\n\n"
+echo "-----------------------20--------------------------------"
+./run samples/deadcode.decaf
+# the functions and vtables left in the assembly, and the vtable slots.
+grep -E '^[[:space:]]+([A-Za-z_][A-Za-z0-9_.]*:|\.word)' tmp.asm |
+  grep -v '_L[0-9]*:\|_string[0-9]*:' |
+  sed 's/^[[:space:]]*//; s/[[:space:]]*#.*//' |
+  diff - samples/deadcode.labels && echo "-- labels as in samples/deadcode.labels"
+
+echo "\n\n\n"
+echo "-----------------------21--------------------------------"
+# the samples with an expected output, through the interpreter and
+# the bytecode.
+./vm-check
+
+echo "\n\n\n"
+echo "-----------------------22--------------------------------"
+# two libraries compiled on their own, the second importing the first,
+# and a program linked with them, see samples/drawing.decaf.
+./dcc samples/shapes.decaf --emit-summary shapes.dsum > shapes.asm &&
+./dcc samples/scaled.decaf --import shapes.dsum --emit-summary scaled.dsum > scaled.asm &&
+./dcc samples/drawing.decaf --import shapes.dsum --import scaled.dsum > tmp.asm &&
+cat defs.asm >> tmp.asm &&
+if command -v spim > /dev/null; then
+  spim -trap_file trap.handler -file tmp.asm | tail -n +2
+else
+  ./dcc-sim tmp.asm
+fi | diff - samples/drawing.linked && echo "-- output as in samples/drawing.linked"
+# the libraries imported in the other order do not match their summaries.
+./dcc samples/drawing.decaf --import scaled.dsum --import shapes.dsum 2>&1 > /dev/null |
+  diff - samples/drawing.mismatch && echo "-- errors as in samples/drawing.mismatch"
+rm -f shapes.dsum shapes.asm scaled.dsum scaled.asm
+
+echo "\n\n\n"
+echo "-----------------------23--------------------------------"
+# --batch with two good files and a bad one: the assembly of each good
+# file as from a single compilation, none for the bad one, its errors
+# under its name, and the exit status of a file with errors.
+rm -rf batch.tmp && mkdir batch.tmp
+cp samples/t1.decaf samples/badlink.decaf samples/t2.decaf batch.tmp/
+./dcc --batch batch.tmp/t1.decaf batch.tmp/badlink.decaf batch.tmp/t2.decaf \
+  -j 2 2> batch.tmp/errors
+echo "-- exit status $? (255 expected)"
+for f in t1 t2; do
+  ./dcc < samples/$f.decaf | cmp - batch.tmp/$f.asm && echo "-- $f.asm as from dcc"
+done
+[ ! -r batch.tmp/badlink.asm ] && echo "-- no badlink.asm"
+{ echo "==> batch.tmp/badlink.decaf <=="; ./dcc < samples/badlink.decaf 2>&1 > /dev/null; } |
+  diff - batch.tmp/errors && echo "-- errors under ==> batch.tmp/badlink.decaf <=="
+rm -rf batch.tmp
+
+echo "\n\n\n"
+echo "-----------------------24--------------------------------"
+# the compile server: a sample, the sample with a line of main edited,
+# whose other functions come from the cache of units with their labels
+# and temps renamed, and the sample again, each as from dcc.
+rm -f server.sock
+./dcc --server server.sock 2> /dev/null &
+i=0
+while [ ! -S server.sock -a $i -lt 50 ]; do sleep 0.1; i=$((i+1)); done
+sed '63s/Print("\\n")/Print("!\\n")/' samples/queue.decaf > server.decaf
+for f in samples/queue.decaf server.decaf samples/queue.decaf; do
+  ./dcc $f > server.expected 2>&1
+  ./dcc --connect server.sock $f > server.actual 2>&1
+  cmp server.expected server.actual && echo "-- $f as from dcc"
+done
+./dcc --connect server.sock --shutdown && wait && echo "-- server shut down"
+rm -f server.sock server.decaf server.expected server.actual
+
+echo "\n\n\n"
+echo "-----------------------25--------------------------------"
+# without spim, which runs the samples of the blocks above, the samples
+# with an expected output run in dcc-sim.
+if command -v spim > /dev/null; then
+  echo "-- spim found, dcc-sim not needed"
+else
+  ./sim-check
+fi
+
+echo "\n\n\n"
+echo "-----------------------26--------------------------------"
+# the samples with an expected output through the x86-64 target, built
+# with gcc and x86defs.c.
+for f in `ls samples | grep '\.out$'`; do
+  name=`basename $f .out`
+  # an expected output of spim, not errors of dcc.
+  head -1 samples/$f | grep -q '^Loaded:' || continue
+  tail -n +2 samples/$f > tmp.expected
+  ./dcc samples/$name.decaf --target x86-64 > tmp.s &&
+  gcc -no-pie -o tmp.x86 tmp.s x86defs.c &&
+  ./tmp.x86 < /dev/null > tmp.actual 2>&1
+  cmp -s tmp.expected tmp.actual && echo "-- $name as in samples/$f" ||
+    echo "-- $name FAILED"
+done
+rm -f tmp.s tmp.x86 tmp.expected tmp.actual
+# the default target is still MIPS, with the assembly of the compiler
+# before the x86-64 target, byte for byte. samples/mips.md5 is to be
+# recorded again with a change of the MIPS code.
+for f in `ls samples | grep '\.decaf$'`; do
+  echo "`./dcc samples/$f 2> /dev/null < /dev/null | md5sum | cut -d' ' -f1`  $f"
+done | diff - samples/mips.md5 && echo "-- MIPS assembly as in samples/mips.md5"
+
+echo "\n\n\n"
+echo "-----------------------27--------------------------------"
+# an instrumented program prints its output, then its counters as in
+# samples/profile.counts.
+./dcc samples/profile.decaf --instrument > tmp.asm &&
+./dcc-sim tmp.asm > profile.tmp
+# the profile starts with a newline.
+sed '/^# profile$/,$d' profile.tmp > profile.run
+{ tail -n +2 samples/profile.out; echo; } | diff - profile.run &&
+  echo "-- output as in samples/profile.out"
+sed -n '/^# profile$/,$p' profile.tmp | diff - samples/profile.counts &&
+  echo "-- counters as in samples/profile.counts"
+rm -f profile.tmp profile.run
+
+echo "\n\n\n"
+echo "-----------------------28--------------------------------"
+# the blocks laid out with the profile of samples/profile.decaf: the
+# output is the same, and the paths to _Halt of the runtime checks, which
+# never run, are the last blocks of their functions.
+./dcc samples/profile.decaf --instrument > tmp.asm &&
+./dcc-sim tmp.asm > profile.tmp &&
+./dcc samples/profile.decaf --profile-use profile.tmp > tmp.asm
+tail -n +2 samples/profile.out > profile.run
+./dcc-sim tmp.asm | diff - profile.run && echo "-- output as in samples/profile.out"
+awk '/^\t# BeginFunc/ { fn = label }
+     /^  [^ \t]+:$/ { label = $1; halt = 0 }
+     /jal _Halt/ { halt = 1; seen[fn] = 1; next }
+     /^\t  [a-z]/ { halt = 0 }
+     /^\t# EndFunc/ && seen[fn] && !halt { print "-- " fn " FAILED"; bad = 1 }
+     END { exit bad }' tmp.asm &&
+  echo "-- the paths to _Halt at the end of their functions"
+rm -f profile.tmp profile.run
+
+echo "\n\n\n"
+echo "-----------------------29--------------------------------"
+# the trace of -d sttrace and tac+ for a program with more records than
+# the ring keeps: with the emission on 4 threads each record is whole,
+# and as many are kept and dropped as with one thread.
+./dcc-gen --classes 40 --methods 6 --depth 8 --interfaces 20 --functions 1 > trace.decaf
+for j in 1 4; do
+  ./dcc trace.decaf -j $j -d tac+ sttrace | grep '^+++ (' > trace.$j
+done
+head -1 trace.1
+[ `wc -l < trace.1` -eq `wc -l < trace.4` -a \
+  "`head -1 trace.1`" = "`head -1 trace.4`" ] &&
+  echo "-- as many records on 4 threads"
+grep -v '^+++ (\(tac+\|sttrace\)) [a-z_]*\.cc:[0-9]*: \|^+++ (trace): [0-9]* older records dropped\.$' trace.4 ||
+  echo "-- the records whole"
+# built with -DNO_TRACE there is no trace, and the same assembly.
+rm -rf notrace.tmp && mkdir notrace.tmp
+cp -p *.cc *.h *.y *.l *.c Makefile notrace.tmp/
+(cd notrace.tmp && rm -f *.o && make -s TRACE=-DNO_TRACE dcc > /dev/null 2>&1)
+if [ -x notrace.tmp/dcc ]; then
+  ./notrace.tmp/dcc trace.decaf -d sttrace | grep -q '^+++' ||
+    echo "-- no trace with -DNO_TRACE"
+  ./notrace.tmp/dcc samples/life.decaf > notrace.tmp/life.asm
+  ./dcc samples/life.decaf | cmp - notrace.tmp/life.asm &&
+    echo "-- the same assembly with -DNO_TRACE"
+else
+  echo "-- the build with -DNO_TRACE FAILED"
+fi
+rm -rf notrace.tmp trace.decaf trace.1 trace.4
+
+echo "\n\n\n"
+echo "-----------------------30--------------------------------"
+# the report of --time-report and --stats lists the phases and the
+# counters of samples/t1.report, and the same report in JSON parses and
+# has them too.
+./dcc samples/t1.decaf --time-report --stats 2>&1 > /dev/null |
+  cut -c1-18 | sed 's/ *$//' | diff - samples/t1.report &&
+  echo "-- phases and counters as in samples/t1.report"
+./dcc samples/t1.decaf --time-report --stats --report-json report.json > /dev/null &&
+  python3 -m json.tool report.json > /dev/null && echo "-- report.json parses"
+grep '^  ' samples/t1.report | grep -v '^  \(phase\|total\|peak RSS\)$' |
+  sed 's/^  //' > report.names
+python3 -c 'import json
+r = json.load(open("report.json"))
+for p in r["phases"]: print(p["name"])
+for c in r["counters"]: print(c)' | diff - report.names &&
+  echo "-- the same phases and counters in report.json"
+rm -f report.json report.names
@@ -0,0 +1,41 @@
+/* File: profile.cc
+ * ----------------
+ * Implementation of the Profile.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "profile.h"
+#include <stdio.h>
+#include <string.h>
+
+bool Profile::Read(const char *file) {
+    FILE *f = fopen(file, "r");
+    if (!f) return false;
+    char line[1024], name[1024];
+    bool inProfile = false;
+    while (fgets(line, sizeof(line), f)) {
+        int counter;
+        long count;
+        char end;
+        if (!strcmp(line, "# profile\n")) {
+            inProfile = true;
+        } else if (inProfile &&
+                   sscanf(line, "%1023s %d %ld %c", name, &counter, &count,
+                          &end) == 3 && counter >= 0 && counter < 1 << 20) {
+            std::vector<long> &c = counts[name];
+            if ((int)c.size() <= counter) c.resize(counter + 1, 0);
+            c[counter] += count;
+        } else {
+            inProfile = false;
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+const std::vector<long> *Profile::CountsOf(const char *function) const {
+    std::map<std::string, std::vector<long> >::const_iterator c =
+        counts.find(function);
+    return c == counts.end() ? NULL : &c->second;
+}
@@ -0,0 +1,42 @@
+/* File: profile.h
+ * ---------------
+ * The Profile holds the counts of an instrumented program, read for
+ * --profile-use:
+ *
+ *    dcc prog.decaf --instrument > prog.asm
+ *    dcc-sim prog.asm > prog.prof
+ *    dcc prog.decaf --profile-use prog.prof > prog.asm
+ *
+ * The file is the output of the runs, see CodeGenerator::Instrument:
+ * after each line "# profile", the lines "<function> <counter> <count>"
+ * are read until a line of another form. The counts of several runs, in
+ * one file, are added up. A function whose code changed since the profile
+ * was made is not found, if its number of blocks changed, see
+ * CodeGenerator::LayoutBlocks.
+ *
+ * A Profile is read once and shared by the threads of the compilation.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_profile
+#define _H_profile
+
+#include <map>
+#include <string>
+#include <vector>
+
+class Profile
+{
+  protected:
+    std::map<std::string, std::vector<long> > counts;
+
+  public:
+    // reads a profile, returns false if the file cannot be read.
+    bool Read(const char *file);
+
+    // the counters of a function, or NULL if it is not in the profile.
+    const std::vector<long> *CountsOf(const char *function) const;
+};
+
+#endif
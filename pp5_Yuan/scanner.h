@@ -12,13 +12,24 @@
 
 #define MaxIdentLen 31    // Maximum length for identifiers
 
-extern char *yytext;      // Text of lexeme just scanned
-
-int yylex();              // Defined in the generated lex.yy.c file
-void yyrestart(FILE *fp); // ditto
-
-void InitScanner();                 // Defined in scanner.l user subroutines
-const char *GetLineNumbered(int n); // ditto
+// The whole input stays in memory for the entire compilation, so a token
+// can refer to its text in place instead of a copy. The text is not null
+// terminated.
+struct TokenView {
+    const char *text;
+    int length;
+};
+
+// The scanner is reentrant, these work on the scanner of the compilation
+// running on the current thread, see context.h.
+class CompilationContext;
+
+bool LoadInput();                   // Defined in scanner.l user subroutines
+void UnloadInput(CompilationContext *c); // ditto, of a finished compilation
+bool InitScanner();                 // ditto
+void DestroyScanner();              // ditto
+const char *GetLineNumbered(int n); // ditto, freed with delete[]
+long GetInputOffset(int line, int column); // ditto
 
 #endif
 
@@ -0,0 +1,328 @@
+/* File: server.cc
+ * ---------------
+ * Implementation of CompileServer and CompileClient.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "server.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <sstream>
+#include "context.h"
+#include "unitcache.h"
+#include "arena.h"
+
+static const int MaxLine = 4096;    // the longest request or reply line.
+static const long MaxInput = 64L << 20; // the largest program, in bytes.
+
+/*
+ * Read or write exactly n bytes, false if the connection is closed.
+ */
+static bool ReadAll(int fd, char *buf, size_t n) {
+    while (n > 0) {
+        ssize_t r = read(fd, buf, n);
+        if (r <= 0) return false;
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+static bool WriteAll(int fd, const char *buf, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, buf, n);
+        if (w <= 0) return false;
+        buf += w;
+        n -= w;
+    }
+    return true;
+}
+
+/*
+ * Read a line without its newline.
+ */
+static bool ReadLine(int fd, std::string *line) {
+    line->clear();
+    char c;
+    while (ReadAll(fd, &c, 1)) {
+        if (c == '\n') return true;
+        if (line->size() == MaxLine) return false;
+        *line += c;
+    }
+    return false;
+}
+
+static bool SocketAddress(const char *path, struct sockaddr_un *addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) return false;
+    strcpy(addr->sun_path, path);
+    return true;
+}
+
+CompileServer::CompileServer() {
+    socketPath = NULL;
+    numThreads = 0;
+    cache = NULL;
+}
+
+static void ServerUsage() {
+    printf("Usage:   --server <socket> [-j <jobs>] [-c <cache-size>] "
+           "[-m <megabytes>]\n");
+    exit(2);
+}
+
+void CompileServer::ParseCommandLine(int argc, char *argv[]) {
+    int i = 1, cacheSize = 4096, cacheMegabytes = 256;
+    Assert(i < argc && strcmp(argv[i], "--server") == 0);
+    if (++i == argc) ServerUsage();
+    socketPath = argv[i];
+    for (i++; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0) {
+            if (++i == argc || (numThreads = atoi(argv[i])) <= 0)
+                ServerUsage();
+        } else if (strcmp(argv[i], "-c") == 0) {
+            if (++i == argc || (cacheSize = atoi(argv[i])) <= 0)
+                ServerUsage();
+        } else if (strcmp(argv[i], "-m") == 0) {
+            if (++i == argc || (cacheMegabytes = atoi(argv[i])) <= 0)
+                ServerUsage();
+        } else {
+            ServerUsage();
+        }
+    }
+    if (numThreads == 0) {
+        // one thread per core by default.
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        numThreads = cores > 0 ? cores : 1;
+    }
+    cache = new UnitCache(cacheSize, (size_t)cacheMegabytes << 20);
+}
+
+/*
+ * Compile one program in a context of its own, with the assembly and the
+ * error messages kept in memory. All of the compilation is allocated in
+ * the arena of the input, only the assembly and the messages are copied
+ * out of it.
+ */
+int CompileServer::Compile(Arena *arena, char *input, size_t size,
+                           List<const char*> *debugKeys,
+                           std::string *out, std::string *err) {
+    Arena::current = arena;
+    CompilationContext c;
+    c.input = input;
+    c.inputSize = size;
+    c.numThreads = numThreads;
+    for (int i = 0; i < debugKeys->NumElements(); i++)
+        c.debugKeys->Append(debugKeys->Nth(i));
+    if (debugKeys->NumElements() == 0) c.unitCache = cache;
+    std::ostringstream errStream;
+    c.err = &errStream;
+
+    char *text = NULL;
+    size_t len = 0;
+    c.out = open_memstream(&text, &len);
+    int numErrors = c.out ? c.Compile() : -1;
+    if (c.out) fclose(c.out);
+    Arena::current = NULL;
+    out->assign(text ? text : "", len);
+    free(text);
+    *err = errStream.str();
+    return numErrors;
+}
+
+bool CompileServer::Serve(int fd) {
+    std::string line;
+    if (!ReadLine(fd, &line)) return true;
+    if (line == "shutdown") return false;
+
+    // compile <size> [<debug-key> ...]
+    std::istringstream words(line);
+    std::string word;
+    long size = -1;
+    words >> word >> size;
+    if (word != "compile" || size < 0) return true;
+
+    // the scanner wants two null bytes after the input.
+    Arena *arena = new Arena;
+    char *input = size <= MaxInput ? (char *)arena->Allocate(size + 2)
+                                   : NULL;
+    if (!input) {
+        arena->Release();
+        fprintf(stderr, "dcc: %ld bytes, refused\n", size);
+        const char *reply = "-1 0 0\n";
+        WriteAll(fd, reply, strlen(reply));
+        return true;
+    }
+    if (!ReadAll(fd, input, size)) { arena->Release(); return true; }
+    input[size] = input[size + 1] = '\0';
+    List<const char*> debugKeys;
+    while (words >> word) debugKeys.Append(strdup(word.c_str()));
+
+    struct timeval start, end;
+    gettimeofday(&start, NULL);
+    std::string out, err;
+    int numErrors = Compile(arena, input, size, &debugKeys, &out, &err);
+    gettimeofday(&end, NULL);
+    // the arena stays with the functions the cache keeps of it.
+    cache->End();
+    arena->Release();
+    for (int i = 0; i < debugKeys.NumElements(); i++)
+        free((char *)debugKeys.Nth(i));
+    double ms = (end.tv_sec - start.tv_sec) * 1e3 +
+                (end.tv_usec - start.tv_usec) / 1e3;
+    if (debugKeys.NumElements() == 0)
+        fprintf(stderr, "dcc: %ld bytes, %d errors, %d functions cached, "
+                "%d compiled, %.1f ms\n", size, numErrors, cache->NumHits(),
+                cache->NumMisses(), ms);
+    else
+        fprintf(stderr, "dcc: %ld bytes, %d errors, %.1f ms\n", size,
+                numErrors, ms);
+
+    char reply[MaxLine];
+    snprintf(reply, MaxLine, "%d %zu %zu\n", numErrors, out.size(),
+             err.size());
+    WriteAll(fd, reply, strlen(reply)) &&
+        WriteAll(fd, out.data(), out.size()) &&
+        WriteAll(fd, err.data(), err.size());
+    return true;
+}
+
+int CompileServer::Run() {
+    struct sockaddr_un addr;
+    if (!SocketAddress(socketPath, &addr)) {
+        fprintf(stderr, "Socket path too long: %s\n", socketPath);
+        return 2;
+    }
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath);
+    if (sock < 0 || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(sock, 16) < 0) {
+        perror(socketPath);
+        return 2;
+    }
+    // a client may go away before its reply is written.
+    signal(SIGPIPE, SIG_IGN);
+
+    bool running = true;
+    while (running) {
+        int fd = accept(sock, NULL, NULL);
+        if (fd < 0) continue;
+        running = Serve(fd);
+        close(fd);
+    }
+    close(sock);
+    unlink(socketPath);
+    return 0;
+}
+
+CompileClient::CompileClient() {
+    socketPath = NULL;
+    inputFile = NULL;
+    debugKeys = new List<const char*>;
+    shutdown = false;
+}
+
+static void ClientUsage() {
+    printf("Usage:   --connect <socket> [<file>] "
+           "[-d <debug-key-1> <debug-key-2> ...]\n"
+           "         --connect <socket> --shutdown\n");
+    exit(2);
+}
+
+void CompileClient::ParseCommandLine(int argc, char *argv[]) {
+    int i = 1;
+    Assert(i < argc && strcmp(argv[i], "--connect") == 0);
+    if (++i == argc) ClientUsage();
+    socketPath = argv[i++];
+    if (i < argc && strcmp(argv[i], "--shutdown") == 0) {
+        shutdown = true;
+        if (++i != argc) ClientUsage();
+        return;
+    }
+    if (i < argc && argv[i][0] != '-')
+        inputFile = argv[i++];
+    if (i == argc) return;
+    if (strcmp(argv[i], "-d") != 0) ClientUsage();
+    for (i++; i < argc; i++) {
+        debugKeys->Append(argv[i]);
+    }
+}
+
+int CompileClient::Run() {
+    // the whole program is sent at once.
+    std::string input;
+    if (!shutdown) {
+        FILE *fp = inputFile ? fopen(inputFile, "r") : stdin;
+        if (!fp) {
+            fprintf(stderr, "Cannot read input file %s\n", inputFile);
+            return 2;
+        }
+        char buf[1 << 16];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) input.append(buf, n);
+        if (inputFile) fclose(fp);
+    }
+
+    struct sockaddr_un addr;
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (!SocketAddress(socketPath, &addr) || sock < 0 ||
+        connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        fprintf(stderr, "Cannot connect to the compile server at %s\n",
+                socketPath);
+        return 2;
+    }
+
+    std::string request = "shutdown\n";
+    if (!shutdown) {
+        std::ostringstream line;
+        line << "compile " << input.size();
+        for (int i = 0; i < debugKeys->NumElements(); i++)
+            line << " " << debugKeys->Nth(i);
+        request = line.str() + "\n" + input;
+    }
+    if (!WriteAll(sock, request.data(), request.size())) {
+        fprintf(stderr, "The compile server closed the connection\n");
+        close(sock);
+        return 2;
+    }
+    if (shutdown) {
+        close(sock);
+        return 0;
+    }
+
+    // <errors> <asm-size> <err-size>, then the assembly and the errors.
+    std::string line;
+    int numErrors;
+    size_t outSize, errSize;
+    if (!ReadLine(sock, &line) ||
+        sscanf(line.c_str(), "%d %zu %zu", &numErrors, &outSize,
+               &errSize) != 3) {
+        fprintf(stderr, "The compile server closed the connection\n");
+        close(sock);
+        return 2;
+    }
+    std::string out(outSize, '\0'), err(errSize, '\0');
+    bool ok = ReadAll(sock, &out[0], outSize) &&
+              ReadAll(sock, &err[0], errSize);
+    close(sock);
+    if (!ok) {
+        fprintf(stderr, "The compile server closed the connection\n");
+        return 2;
+    }
+    fwrite(out.data(), 1, out.size(), stdout);
+    fwrite(err.data(), 1, err.size(), stderr);
+    if (numErrors < 0) {
+        if (err.empty())
+            fprintf(stderr, "The compile server cannot compile the program\n");
+        return 2;
+    }
+    return (numErrors == 0 ? 0 : -1);
+}
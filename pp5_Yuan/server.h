@@ -0,0 +1,82 @@
+/* File: server.h
+ * --------------
+ * The CompileServer is a long running compiler which listens on a Unix
+ * socket and compiles the programs sent to it, one after the other:
+ *
+ *    dcc --server <socket> [-j <jobs>] [-c <cache-size>] [-m <megabytes>]
+ *
+ * The code of the functions and methods is kept in a UnitCache from one
+ * request to the next, so after a small edit only the functions edited
+ * are checked and emitted again, see unitcache.h. The cache holds at most
+ * cache-size functions (4096 by default), in compilations of at most the
+ * given megabytes (256 by default). It is not used for requests with
+ * debug keys, whose output depends on the whole compilation.
+ *
+ * Each request is compiled in an Arena of its own (see arena.h), which
+ * is freed after the reply unless the cache keeps some of its functions.
+ *
+ * The CompileClient sends a program to the server and prints the result
+ * as dcc would, the assembly on stdout and the errors on stderr, with the
+ * same exit status:
+ *
+ *    dcc --connect <socket> [<file>] [-d <debug-key> ...]
+ *    dcc --connect <socket> --shutdown
+ *
+ * A request is a line "compile <size> [<debug-key> ...]" followed by the
+ * size bytes of the program, or the line "shutdown". The reply to a
+ * compile request is a line "<errors> <asm-size> <err-size>" followed by
+ * the assembly and the error messages. The number of errors is -1 if the
+ * server cannot compile the request, such as a program larger than 64MB.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_server
+#define _H_server
+
+#include <string>
+#include "list.h"
+
+class UnitCache;
+class Arena;
+
+class CompileServer
+{
+  protected:
+    const char *socketPath;
+    int numThreads;
+    UnitCache *cache;
+
+    // serves one connection, returns false on a shutdown request.
+    bool Serve(int fd);
+    int Compile(Arena *arena, char *input, size_t size,
+                List<const char*> *debugKeys, std::string *out,
+                std::string *err);
+
+  public:
+    // constructor.
+    CompileServer();
+    // the arguments after --server.
+    void ParseCommandLine(int argc, char *argv[]);
+    // serves the requests until a shutdown, returns the exit status.
+    int Run();
+};
+
+class CompileClient
+{
+  protected:
+    const char *socketPath;
+    const char *inputFile;          // NULL for stdin.
+    List<const char*> *debugKeys;
+    bool shutdown;
+
+  public:
+    // constructor.
+    CompileClient();
+    // the arguments after --connect.
+    void ParseCommandLine(int argc, char *argv[]);
+    // sends the request and prints the reply, returns the exit status.
+    int Run();
+};
+
+#endif
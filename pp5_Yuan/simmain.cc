@@ -0,0 +1,113 @@
+/* File: simmain.cc
+ * ----------------
+ * The main() routine of dcc-sim, the MIPS simulator, see mipssim.h.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include <libgen.h>
+#include <limits.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include "mipssim.h"
+#include "context.h"
+
+static void Usage() {
+    printf("Usage:   dcc-sim [--counts] [--limit <insts>] "
+           "<file.decaf | file.asm> ...\n");
+    exit(2);
+}
+
+static bool ReadFile(const char *file, std::string *text) {
+    FILE *f = fopen(file, "r");
+    if (!f) return false;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text->append(buf, n);
+    fclose(f);
+    return true;
+}
+
+/*
+ * Compiles a Decaf file into assembly in memory, returns false if it has
+ * errors or cannot be read.
+ */
+static bool Compile(const char *file, std::string *text) {
+    CompilationContext c;
+    c.inputFile = file;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    c.numThreads = cores > 0 ? cores : 1;
+    char *asmText = NULL;
+    size_t len = 0;
+    c.out = open_memstream(&asmText, &len);
+    if (!c.out) return false;
+    int numErrors = c.Compile();
+    fclose(c.out);
+    text->assign(asmText ? asmText : "", len);
+    free(asmText);
+    if (numErrors < 0) fprintf(stderr, "Cannot read %s.\n", file);
+    return numErrors == 0;
+}
+
+/*
+ * The defs.asm next to dcc-sim, or in the current directory.
+ */
+static bool ReadDefs(std::string *text) {
+    char exe[PATH_MAX];
+    ssize_t n = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (n > 0) {
+        exe[n] = '\0';
+        std::string defs = std::string(dirname(exe)) + "/defs.asm";
+        if (ReadFile(defs.c_str(), text)) return true;
+    }
+    return ReadFile("defs.asm", text);
+}
+
+int main(int argc, char *argv[]) {
+    MipsSim sim(stdout, &std::cerr);
+    bool printCounts = false;
+    int i = 1;
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i++) {
+        if (strcmp(argv[i], "--counts") == 0) {
+            printCounts = true;
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            char *end;
+            unsigned long long n = strtoull(argv[++i], &end, 10);
+            if (*end || n == 0) Usage();
+            sim.SetLimit(n);
+        } else {
+            Usage();
+        }
+    }
+    if (i == argc) Usage();
+
+    for (; i < argc; i++) {
+        const char *file = argv[i];
+        size_t len = strlen(file);
+        std::string text;
+        if (len > 6 && strcmp(file + len - 6, ".decaf") == 0) {
+            if (!Compile(file, &text)) return 2;
+        } else if (!ReadFile(file, &text)) {
+            fprintf(stderr, "Cannot read %s.\n", file);
+            return 2;
+        }
+        if (!sim.Assemble(text.c_str(), file)) return 2;
+    }
+    if (!sim.IsDefined("_Halt")) {
+        std::string defs;
+        if (!ReadDefs(&defs)) {
+            fprintf(stderr, "Cannot find defs.asm.\n");
+            return 2;
+        }
+        if (!sim.Assemble(defs.c_str(), "defs.asm")) return 2;
+    }
+    if (!sim.Link()) return 2;
+
+    int status = sim.Run();
+    fflush(stdout);
+    if (printCounts) sim.PrintCounts(std::cerr);
+    return status;
+}
@@ -0,0 +1,178 @@
+/* File: stats.cc
+ * --------------
+ * Implementation of Stats.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <fstream>
+#include "context.h"
+
+// counted by operator new, see arena.cc.
+std::atomic<long> Stats::allocated(0);
+std::atomic<bool> Stats::countAllocations(false);
+
+static const char *CounterNames[Stats::NumCounters] = {
+    "tokens", "ast_nodes", "symbols", "scopes", "temps", "tac_instructions",
+    "spills", "reloads"
+};
+
+Stats::Stats(bool t, bool c) : timeReport(t), counts(c) {
+    current = -1;
+    for (int i = 0; i < NumCounters; i++) counters[i] = 0;
+    if (timeReport) countAllocations = true;
+}
+
+/*
+ * The peak resident set of the process, in KB.
+ */
+static long PeakRss() {
+    struct rusage u;
+    return getrusage(RUSAGE_SELF, &u) == 0 ? u.ru_maxrss : 0;
+}
+
+Stats::Sample Stats::Now() {
+    struct timespec w, c;
+    clock_gettime(CLOCK_MONOTONIC, &w);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &c);
+    Sample s;
+    s.wall = w.tv_sec + w.tv_nsec * 1e-9;
+    s.cpu = c.tv_sec + c.tv_nsec * 1e-9;
+    s.alloc = allocated.load(std::memory_order_relaxed);
+    return s;
+}
+
+void Stats::StartPhase(const char *name) {
+    StopPhase();
+    for (current = 0; current < (int)phases.size(); current++)
+        if (!strcmp(phases[current].name, name)) break;
+    if (current == (int)phases.size()) {
+        Phase p = { name, 0, 0, 0 };
+        phases.push_back(p);
+    }
+    start = Now();
+}
+
+void Stats::StopPhase() {
+    if (current < 0) return;
+    Sample end = Now();
+    Phase &p = phases[current];
+    p.wall += end.wall - start.wall;
+    p.cpu += end.cpu - start.cpu;
+    p.alloc += end.alloc - start.alloc;
+    current = -1;
+}
+
+void Stats::SplitPhase(const char *from, const char *name,
+                       const Sample &spent) {
+    int f = 0, n = 0;
+    while (f < (int)phases.size() && strcmp(phases[f].name, from)) f++;
+    if (f == (int)phases.size()) return;
+    while (n < (int)phases.size() && strcmp(phases[n].name, name)) n++;
+    if (n == (int)phases.size()) {
+        Phase p = { name, 0, 0, 0 };
+        phases.insert(phases.begin() + f, p);
+        if (current >= f) current++;
+        n = f++;
+    }
+    // the running phase adds up its time when it stops.
+    phases[f].wall -= spent.wall;
+    phases[f].cpu -= spent.cpu;
+    phases[f].alloc -= spent.alloc;
+    phases[n].wall += spent.wall;
+    phases[n].cpu += spent.cpu;
+    phases[n].alloc += spent.alloc;
+}
+
+void Stats::PrintText(std::ostream &os) {
+    char line[128];
+    if (timeReport) {
+        os << "Time report:\n";
+        snprintf(line, sizeof(line), "  %-16s %10s %10s %12s\n", "phase",
+                 "wall ms", "cpu ms", "alloc KB");
+        os << line;
+        Phase total = { "total", 0, 0, 0 };
+        for (size_t i = 0; i <= phases.size(); i++) {
+            Phase &p = i < phases.size() ? phases[i] : total;
+            snprintf(line, sizeof(line), "  %-16s %10.3f %10.3f %12.1f\n",
+                     p.name, p.wall * 1e3, p.cpu * 1e3, p.alloc / 1024.0);
+            os << line;
+            total.wall += p.wall;
+            total.cpu += p.cpu;
+            total.alloc += p.alloc;
+        }
+        snprintf(line, sizeof(line), "  %-16s %10ld KB\n", "peak RSS",
+                 PeakRss());
+        os << line;
+    }
+    if (counts) {
+        os << "Statistics:\n";
+        for (int i = 0; i < NumCounters; i++) {
+            snprintf(line, sizeof(line), "  %-16s %10ld\n", CounterNames[i],
+                     counters[i].load());
+            os << line;
+        }
+    }
+}
+
+void Stats::PrintJson(std::ostream &os) {
+    char field[256];
+    const char *sep = "";
+    os << "{";
+    if (timeReport) {
+        Phase total = { "total", 0, 0, 0 };
+        os << "\"phases\": [";
+        for (size_t i = 0; i <= phases.size(); i++) {
+            Phase &p = i < phases.size() ? phases[i] : total;
+            snprintf(field, sizeof(field), "{\"name\": \"%s\", \"wall_ms\": "
+                     "%.3f, \"cpu_ms\": %.3f, \"alloc_bytes\": %ld}",
+                     p.name, p.wall * 1e3, p.cpu * 1e3, p.alloc);
+            if (i < phases.size()) {
+                os << (i > 0 ? ", " : "") << field;
+                total.wall += p.wall;
+                total.cpu += p.cpu;
+                total.alloc += p.alloc;
+            } else {
+                os << "], \"total\": " << field;
+            }
+        }
+        os << ", \"peak_rss_kb\": " << PeakRss();
+        sep = ", ";
+    }
+    if (counts) {
+        os << sep << "\"counters\": {";
+        for (int i = 0; i < NumCounters; i++) {
+            os << (i > 0 ? ", " : "") << "\"" << CounterNames[i] << "\": "
+               << counters[i].load();
+        }
+        os << "}";
+    }
+    os << "}\n";
+}
+
+bool Stats::Report(std::ostream &os, const char *jsonFile) {
+    StopPhase();
+    countAllocations = false;
+    if (!jsonFile) {
+        PrintText(os);
+        return true;
+    }
+    std::ofstream f(jsonFile);
+    PrintJson(f);
+    f.close();
+    return !f.fail();
+}
+
+void Stats::Start(const char *phase) {
+    if (ctx->stats) ctx->stats->StartPhase(phase);
+}
+
+void Stats::Count(Counter c, long n) {
+    if (ctx && ctx->stats) ctx->stats->Increment(c, n);
+}
@@ -0,0 +1,107 @@
+/* File: stats.h
+ * -------------
+ * The Stats of a compilation, for --time-report and --stats:
+ *
+ *    dcc prog.decaf --time-report --stats [--report-json <file>]
+ *
+ * The time report has a line per phase of the compiler: reading the
+ * input, scanning, parsing, the import of the libraries, the four check
+ * passes over the declarations and the check of the function bodies (the
+ * passes fused, see CheckTasks), the emission of the Tac (with
+ * --instrument and --profile-use, which run on each function as it is
+ * emitted), the removal of the unreachable code, the emission for the
+ * target and the link of the libraries. Each phase has its wall time,
+ * its CPU time (of all threads, so the parallel phases may take more CPU
+ * than wall time) and the bytes allocated by new during the phase, and
+ * the report ends with the peak resident set of the process. The
+ * scanner is called by the parser for each token, its time is added up
+ * by the parser and taken from the parse at its end.
+ *
+ * The statistics are counters: the tokens, the AST nodes, the symbols
+ * and the scopes of the symbol table, the temps, the Tac instructions
+ * emitted for the target, and the spills and the reloads of registers
+ * of the MIPS target (each variable is stored after and loaded before
+ * each instruction, see Mips::SpillRegister).
+ *
+ * The report is printed on the error output after the compilation, or
+ * written as JSON to the given file, for the dashboards:
+ *
+ *    {"phases": [{"name": "scan", "wall_ms": 0.412, "cpu_ms": 0.410,
+ *      "alloc_bytes": 0}, ...], "total": {...}, "peak_rss_kb": 5120,
+ *     "counters": {"tokens": 1234, ...}}
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_stats
+#define _H_stats
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class Stats
+{
+  public:
+    typedef enum {
+        Tokens, AstNodes, Symbols, Scopes, Temps, TacInstructions, Spills,
+        Reloads, NumCounters
+    } Counter;
+
+    // the clocks and the bytes allocated at a time, or spent between two
+    // times.
+    struct Sample {
+        double wall, cpu;
+        long alloc;
+    };
+
+  protected:
+    struct Phase {
+        const char *name;
+        double wall, cpu;           // in seconds.
+        long alloc;                 // bytes.
+    };
+
+    bool timeReport, counts;
+    std::vector<Phase> phases;
+    int current;                    // the running phase, or -1.
+    Sample start;                   // of the running phase.
+    std::atomic<long> counters[NumCounters];
+
+    void PrintText(std::ostream &os);
+    void PrintJson(std::ostream &os);
+
+  public:
+    // the bytes allocated by new, counted while a report is made.
+    static std::atomic<long> allocated;
+    static std::atomic<bool> countAllocations;
+
+    Stats(bool timeReport, bool counts);
+
+    static Sample Now();
+
+    // stops the running phase and starts the named one, the times of a
+    // phase run several times are added up.
+    void StartPhase(const char *name);
+    void StopPhase();
+    // moves spent from the phase from to the named one, which is put
+    // before it if new. For a phase run in many short pieces within
+    // another, such as the scanner within the parser, timed by the caller
+    // and added up once.
+    void SplitPhase(const char *from, const char *name, const Sample &spent);
+    void Increment(Counter c, long n) {
+        counters[c].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // prints the report, or writes it as JSON to the file if not NULL.
+    // Returns false if the file cannot be written.
+    bool Report(std::ostream &os, const char *jsonFile);
+
+    // the same for the compilation of the current thread, if it makes a
+    // report.
+    static void Start(const char *phase);
+    static void Count(Counter c, long n = 1);
+};
+
+#endif
@@ -0,0 +1,386 @@
+/* File: summary.cc
+ * ----------------
+ * Implementation of Summary.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "summary.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ast_decl.h"
+#include "ast_type.h"
+#include "codegen.h"
+#include "context.h"
+#include "errors.h"
+
+static const char Magic[4] = { 'D', 'S', 'U', 'M' };
+static const uint32_t Version = 1;
+
+/*
+ * The strings of a summary, each kept once. The empty string is at 0.
+ */
+class StringTable
+{
+  public:
+    std::string text;
+    std::map<std::string, uint32_t> offsets;
+
+    StringTable() : text(1, '\0') { offsets[""] = 0; }
+    uint32_t Add(const std::string &s) {
+        std::map<std::string, uint32_t>::iterator p = offsets.find(s);
+        if (p != offsets.end()) return p->second;
+        uint32_t offset = text.size();
+        text.append(s.c_str(), s.size() + 1);
+        offsets[s] = offset;
+        return offset;
+    }
+};
+
+typedef std::vector<Summary::Record> Records;
+
+static void AddRecord(Records *records, Summary::RecordKind kind,
+                      uint32_t name, uint32_t type, int line, int value,
+                      int count = 0) {
+    Summary::Record r;
+    r.kind = kind;
+    r.count = count;
+    r.name = name;
+    r.type = type;
+    r.line = line;
+    r.value = value;
+    records->push_back(r);
+}
+
+static std::string TypeName(Type *t) {
+    std::ostringstream s;
+    s << t;
+    return s.str();
+}
+
+/*
+ * The name of a vtable slot, Class.method, before the methods are
+ * prefixed.
+ */
+static std::string SlotName(FnDecl *fn) {
+    Decl *owner = dynamic_cast<Decl*>(fn->GetParent());
+    return std::string(owner->GetId()->GetIdName()) + "." +
+           fn->GetId()->GetIdName();
+}
+
+static void WriteFunction(FnDecl *fn, Records *records, StringTable *st) {
+    List<VarDecl*> *formals = fn->GetFormals();
+    AddRecord(records, Summary::R_Function,
+              st->Add(fn->GetId()->GetIdName()),
+              st->Add(TypeName(fn->GetType())),
+              fn->GetLocation()->first_line, fn->GetVTableOffset(),
+              formals->NumElements());
+    for (int i = 0; i < formals->NumElements(); i++) {
+        VarDecl *v = formals->Nth(i);
+        AddRecord(records, Summary::R_Formal,
+                  st->Add(v->GetId()->GetIdName()),
+                  st->Add(TypeName(v->GetType())),
+                  v->GetLocation()->first_line, 0);
+    }
+}
+
+bool Summary::Write(const char *file, List<Decl*> *decls, int globalBase,
+                    int globalSize) {
+    Records records;
+    StringTable st;
+    for (int i = 0; i < decls->NumElements(); i++) {
+        Decl *d = decls->Nth(i);
+        if (d->IsImported() || d->IsVarDecl()) continue;
+        const char *name = d->GetId()->GetIdName();
+        int line = d->GetLocation()->first_line;
+
+        if (d->IsFnDecl()) {
+            WriteFunction(dynamic_cast<FnDecl*>(d), &records, &st);
+        } else if (d->IsInterfaceDecl()) {
+            InterfaceDecl *itfc = dynamic_cast<InterfaceDecl*>(d);
+            AddRecord(&records, R_Interface, st.Add(name), 0, line,
+                      itfc->GetInterfaceNum());
+            List<Decl*> *members = itfc->GetMembers();
+            for (int j = 0; j < members->NumElements(); j++) {
+                WriteFunction(dynamic_cast<FnDecl*>(members->Nth(j)),
+                              &records, &st);
+            }
+            AddRecord(&records, R_End, 0, 0, line, 0);
+        } else {
+            ClassDecl *c = dynamic_cast<ClassDecl*>(d);
+            NamedType *ex = c->GetExtends();
+            AddRecord(&records, R_Class, st.Add(name),
+                      ex ? st.Add(ex->GetId()->GetIdName()) : 0, line,
+                      c->GetInstanceSize());
+            List<NamedType*> *implements = c->GetImplements();
+            for (int j = 0; j < implements->NumElements(); j++) {
+                AddRecord(&records, R_Implements,
+                          st.Add(implements->Nth(j)->GetId()->GetIdName()),
+                          0, line, 0);
+            }
+            List<Decl*> *members = c->GetMembers();
+            for (int j = 0; j < members->NumElements(); j++) {
+                Decl *m = members->Nth(j);
+                if (m->IsFnDecl()) {
+                    WriteFunction(dynamic_cast<FnDecl*>(m), &records, &st);
+                } else {
+                    VarDecl *v = dynamic_cast<VarDecl*>(m);
+                    AddRecord(&records, R_Field,
+                              st.Add(v->GetId()->GetIdName()),
+                              st.Add(TypeName(v->GetType())),
+                              v->GetLocation()->first_line,
+                              v->GetMemberOffset());
+                }
+            }
+            ClassLayout *layout = c->GetLayout();
+            for (int j = 0; j < layout->NumMethods(); j++) {
+                AddRecord(&records, R_Slot,
+                          st.Add(SlotName(layout->GetMethod(j))), 0, line,
+                          j * CodeGenerator::VarSize);
+            }
+            AddRecord(&records, R_End, 0, 0, line, 0);
+        }
+    }
+
+    Header h;
+    memcpy(h.magic, Magic, sizeof(Magic));
+    h.version = Version;
+    h.numRecords = records.size();
+    h.stringsSize = st.text.size();
+    h.globalBase = globalBase;
+    h.globalSize = globalSize;
+
+    FILE *fp = fopen(file, "wb");
+    if (!fp) return false;
+    fwrite(&h, sizeof(h), 1, fp);
+    if (!records.empty())
+        fwrite(&records[0], sizeof(Record), records.size(), fp);
+    fwrite(st.text.data(), 1, st.text.size(), fp);
+    return fclose(fp) == 0;
+}
+
+const char *Summary::LabelPrefix(const char *file) {
+    const char *base = strrchr(file, '/');
+    base = base ? base + 1 : file;
+    std::string prefix;
+    for (const char *p = base; *p && *p != '.' && prefix.size() < 24; p++) {
+        if (isalnum(*p) || *p == '_') prefix += *p;
+    }
+    if (prefix.empty()) prefix = "lib";
+    return CopyString((prefix + "_").c_str());
+}
+
+Summary::Summary(const char *f) {
+    file = f;
+    header = NULL;
+    records = NULL;
+    strings = NULL;
+    decls = new List<Decl*>;
+    starts = new List<const Record*>;
+}
+
+/*
+ * The imported declarations are placed at the line where they were in the
+ * library.
+ */
+static yyltype LocationAt(int line) {
+    yyltype loc;
+    memset(&loc, 0, sizeof(loc));
+    loc.first_line = loc.last_line = line;
+    return loc;
+}
+
+Type *Summary::ReadType(uint32_t offset, int line) {
+    std::string name = String(offset);
+    int dims = 0;
+    while (name.size() > 2 && name.compare(name.size() - 2, 2, "[]") == 0) {
+        name.erase(name.size() - 2);
+        dims++;
+    }
+    Type *basic[] = { Type::intType, Type::doubleType, Type::boolType,
+                      Type::voidType, Type::stringType };
+    Type *t = NULL;
+    for (size_t i = 0; i < sizeof(basic) / sizeof(basic[0]); i++) {
+        if (name == basic[i]->GetTypeName()) t = basic[i];
+    }
+    if (!t) t = new NamedType(new Identifier(LocationAt(line), name.c_str()));
+    while (dims-- > 0) t = new ArrayType(LocationAt(line), t);
+    return t;
+}
+
+/*
+ * A function and its formals, r is moved past them.
+ */
+Decl *Summary::ReadFunction(const Record **r) {
+    const Record *f = (*r)++, *end = records + header->numRecords;
+    List<VarDecl*> *formals = new List<VarDecl*>;
+    for (uint32_t i = 0; i < f->count; i++, (*r)++) {
+        if (*r == end || (*r)->kind != R_Formal) return NULL;
+        formals->Append(new VarDecl(
+                new Identifier(LocationAt((*r)->line), String((*r)->name)),
+                ReadType((*r)->type, (*r)->line)));
+    }
+    return new FnDecl(new Identifier(LocationAt(f->line), String(f->name)),
+                      ReadType(f->type, f->line), formals);
+}
+
+Summary *Summary::Read(const char *file) {
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void *p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(Header))
+        p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return NULL;
+
+    // the summary stays mapped, the strings are read in place.
+    Summary *s = new Summary(file);
+    s->header = (const Header *)p;
+    s->records = (const Record *)(s->header + 1);
+    s->strings = (const char *)(s->records + s->header->numRecords);
+    const Header *h = s->header;
+    if (memcmp(h->magic, Magic, sizeof(Magic)) || h->version != Version ||
+        h->stringsSize == 0 ||
+        sizeof(Header) + (off_t)h->numRecords * sizeof(Record) +
+            h->stringsSize != (size_t)st.st_size ||
+        s->strings[h->stringsSize - 1] != '\0')
+        return NULL;
+    const Record *r, *end = s->records + h->numRecords;
+    for (r = s->records; r < end; r++) {
+        if (r->name >= h->stringsSize || r->type >= h->stringsSize)
+            return NULL;
+    }
+
+    r = s->records;
+    while (r < end) {
+        const Record *start = r;
+        Decl *d = NULL;
+        if (r->kind == R_Function) {
+            d = s->ReadFunction(&r);
+        } else if (r->kind == R_Interface) {
+            List<Decl*> *members = new List<Decl*>;
+            for (r++; r < end && r->kind == R_Function; ) {
+                Decl *m = s->ReadFunction(&r);
+                if (!m) return NULL;
+                members->Append(m);
+            }
+            if (r == end || r->kind != R_End) return NULL;
+            r++;
+            d = new InterfaceDecl(new Identifier(LocationAt(start->line),
+                                                 s->String(start->name)),
+                                  members);
+        } else if (r->kind == R_Class) {
+            NamedType *ex = NULL;
+            if (r->type) {
+                ex = new NamedType(new Identifier(LocationAt(r->line),
+                                                  s->String(r->type)));
+            }
+            List<NamedType*> *implements = new List<NamedType*>;
+            List<Decl*> *members = new List<Decl*>;
+            for (r++; r < end && r->kind != R_End; ) {
+                if (r->kind == R_Implements) {
+                    implements->Append(new NamedType(new Identifier(
+                            LocationAt(r->line), s->String(r->name))));
+                    r++;
+                } else if (r->kind == R_Field) {
+                    members->Append(new VarDecl(
+                            new Identifier(LocationAt(r->line),
+                                           s->String(r->name)),
+                            s->ReadType(r->type, r->line)));
+                    r++;
+                } else if (r->kind == R_Function) {
+                    Decl *m = s->ReadFunction(&r);
+                    if (!m) return NULL;
+                    members->Append(m);
+                } else if (r->kind == R_Slot) {
+                    r++; // checked with the layout.
+                } else {
+                    return NULL;
+                }
+            }
+            if (r == end) return NULL;
+            r++;
+            d = new ClassDecl(new Identifier(LocationAt(start->line),
+                                             s->String(start->name)),
+                              ex, implements, members);
+        }
+        if (!d) return NULL;
+        d->SetImported();
+        s->decls->Append(d);
+        s->starts->Append(start);
+    }
+    return s;
+}
+
+/*
+ * The layout of an imported class or interface, computed as the one of a
+ * declaration in the program, is the one of the library.
+ */
+bool Summary::CheckLayout(Decl *d, const Record *r) {
+    if (d->IsInterfaceDecl())
+        return dynamic_cast<InterfaceDecl*>(d)->GetInterfaceNum() == r->value;
+    if (!d->IsClassDecl()) return true;
+
+    ClassDecl *c = dynamic_cast<ClassDecl*>(d);
+    ClassLayout *layout = c->GetLayout();
+    if (!layout || c->GetInstanceSize() != r->value) return false;
+    List<Decl*> *members = c->GetMembers();
+    int m = 0, slots = 0;
+    for (r++; r->kind != R_End; r++) {
+        if (r->kind == R_Field) {
+            VarDecl *v = dynamic_cast<VarDecl*>(members->Nth(m++));
+            if (v->GetMemberOffset() != r->value) return false;
+        } else if (r->kind == R_Function) {
+            FnDecl *fn = dynamic_cast<FnDecl*>(members->Nth(m++));
+            if (fn->GetVTableOffset() != r->value) return false;
+            r += r->count; // the formals.
+        } else if (r->kind == R_Slot) {
+            int slot = r->value / CodeGenerator::VarSize;
+            if (slot >= layout->NumMethods() ||
+                SlotName(layout->GetMethod(slot)) != String(r->name))
+                return false;
+            slots++;
+        }
+    }
+    return slots == layout->NumMethods();
+}
+
+void Summary::CheckLayouts() {
+    for (int i = 0; i < decls->NumElements(); i++) {
+        Decl *d = decls->Nth(i);
+        if (!CheckLayout(d, starts->Nth(i))) {
+            ReportError::Formatted(NULL, "Layout of '%s' does not match the "
+                    "summary %s.", d->GetId()->GetIdName(), file);
+        }
+    }
+}
+
+void Summary::LinkCode() {
+    std::string path(file);
+    size_t dot = path.rfind('.');
+    if (dot != std::string::npos && path.find('/', dot) == std::string::npos)
+        path.erase(dot);
+    path += IsDebugOn("tac") ? ".tac" : ".asm";
+
+    FILE *fp = fopen(path.c_str(), "r");
+    if (!fp) {
+        ReportError::Formatted(NULL, "Cannot read the code of the library "
+                "%s.", path.c_str());
+        return;
+    }
+    char buf[1 << 16];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+        fwrite(buf, 1, n, ctx->out);
+    fclose(fp);
+}
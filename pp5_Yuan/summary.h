@@ -0,0 +1,111 @@
+/* File: summary.h
+ * ---------------
+ * A Summary records the declarations of a library, so a program can be
+ * compiled against the library without its source:
+ *
+ *    dcc lib.decaf --emit-summary lib.dsum > lib.asm
+ *    dcc prog.decaf --import lib.dsum > prog.asm
+ *
+ * The summary holds the interfaces, the classes and the global functions
+ * of the library with their signatures, the interface numbers, the vtable
+ * slots, the field offsets and instance sizes, and the range of the
+ * global vars of the library. The global vars themselves and the function
+ * bodies are private to the library. A library needs no main function,
+ * none of its code is removed as unreachable, and its labels and strings
+ * are prefixed by the name of the summary file, so they do not clash
+ * with those of the program.
+ *
+ * An import adds the declarations of the summary in front of those of the
+ * program, they are checked as if they were written there but never
+ * emitted. The layouts computed for the imported classes are checked
+ * against those of the summary. The code of the library, lib.asm next to
+ * lib.dsum (lib.tac with -d tac), is appended to the output of the
+ * program, and the global vars of the program are placed after those of
+ * the library. A library may import others, which the program imports
+ * too, in the same order, and only the program links their code.
+ *
+ * The file is a header, an array of fixed size records and a table of
+ * null terminated strings. It is mapped and read in place.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_summary
+#define _H_summary
+
+#include <stdint.h>
+#include "list.h"
+
+class Decl;
+class ClassDecl;
+class InterfaceDecl;
+class FnDecl;
+class Type;
+
+class Summary
+{
+  public:
+    // the records, in the order of the declarations.
+    enum RecordKind {
+        R_Interface,                // name, value = interface number.
+        R_Class,                    // name, type = extends, value = size.
+        R_Implements,               // name.
+        R_Field,                    // name, type, value = offset.
+        R_Slot,                     // name = Class.method, value = offset.
+        R_Function,                 // name, type = return type, count =
+                                    // formals, value = vtable offset.
+        R_Formal,                   // name, type.
+        R_End                       // of an interface or a class.
+    };
+    struct Record {
+        uint32_t kind;
+        uint32_t count;
+        uint32_t name;              // offsets in the string table.
+        uint32_t type;
+        int32_t line;
+        int32_t value;
+    };
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t numRecords;
+        uint32_t stringsSize;
+        int32_t globalBase, globalSize;
+    };
+
+  protected:
+    const char *file;
+    const Header *header;
+    const Record *records;
+    const char *strings;
+    List<Decl*> *decls;             // made by Read.
+    List<const Record*> *starts;    // the first record of each decl.
+
+    Summary(const char *file);
+    const char * String(uint32_t offset) { return strings + offset; }
+    Type * ReadType(uint32_t offset, int line);
+    Decl * ReadFunction(const Record **r);
+    bool CheckLayout(Decl *d, const Record *r);
+
+  public:
+    // writes the summary of the checked program, returns false if the
+    // file cannot be written.
+    static bool Write(const char *file, List<Decl*> *decls, int globalBase,
+                      int globalSize);
+    // the prefix of the labels of a library, made of the file name.
+    static const char * LabelPrefix(const char *file);
+    // reads a summary, returns NULL if it cannot be read.
+    static Summary * Read(const char *file);
+    // the declarations of the library, marked as imported.
+    List<Decl*> * GetDecls() { return decls; }
+    const char * GetFile() { return file; }
+    int GetGlobalBase() { return header->globalBase; }
+    int GetGlobalEnd() { return header->globalBase + header->globalSize; }
+    // reports the imported classes and interfaces whose layout is not
+    // the one of the summary, after the classes are laid out.
+    void CheckLayouts();
+    // appends the code of the library to the output.
+    void LinkCode();
+};
+
+#endif
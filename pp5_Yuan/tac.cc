@@ -4,14 +4,19 @@
  */
 
 #include "tac.h"
-#include "mips.h"
+#include "target.h"
+#include "context.h"
 #include <cstring>
 
 Location::Location(Segment s, int o, const char *name) :
-    variableName(strdup(name)), segment(s), offset(o), base(NULL) {}
+    variableName(CopyString(name)), segment(s), offset(o), base(NULL) {}
 
 Location::Location(Segment s, int o, const char *name, Location *b) :
-    variableName(strdup(name)), segment(s), offset(o), base(b) {}
+    variableName(CopyString(name)), segment(s), offset(o), base(b) {}
+
+void Location::SetName(const char *name) {
+    variableName = CopyString(name);
+}
 
 void Location::Print() {
     const char *s = (segment == fpRelative) ? "FP" : "GP";
@@ -19,65 +24,86 @@ void Location::Print() {
     printf(" ~~[%s,%s,%d,%s]", variableName, s, offset, b);
 }
 
+/* The printed form is only made when it is needed, the names of the
+ * labels and temps of a function are final once the function is appended
+ * to the code of the program, see CodeGenerator::Append.
+ */
 void Instruction::Print() {
-    printf("\t%s ;\n", printed);
+    Format();
+    fprintf(ctx->out, "\t%s ;\n", printed);
 }
 
-void Instruction::Emit(Mips *mips) {
-    Mips::CurrentInstruction ci(*mips, this);
+void Instruction::Emit(Target *target) {
+    Format();
     if (*printed)
-        mips->Emit("# %s", printed);   // emit TAC as comment into assembly
-    EmitSpecific(mips);
+        target->EmitComment(printed);   // emit TAC as comment into assembly
+    EmitSpecific(target);
 }
 
 LoadConstant::LoadConstant(Location *d, int v)
   : dst(d), val(v) {
     Assert(dst != NULL);
+}
+
+void LoadConstant::Format() {
     sprintf(printed, "%s = %d", dst->GetName(), val);
 }
 
-void LoadConstant::EmitSpecific(Mips *mips) {
-    mips->EmitLoadConstant(dst, val);
+void LoadConstant::EmitSpecific(Target *target) {
+    target->EmitLoadConstant(dst, val);
 }
 
-LoadStringConstant::LoadStringConstant(Location *d, const char *s)
+LoadStringConstant::LoadStringConstant(Location *d, const char *s, int len)
   : dst(d) {
     Assert(dst != NULL && s != NULL);
+    if (len < 0) len = strlen(s);
     const char *quote = (*s == '"') ? "" : "\"";
-    str = new char[strlen(s) + 2*strlen(quote) + 1];
-    sprintf(str, "%s%s%s", quote, s, quote);
-    quote = (strlen(str) > 50) ? "...\"" : "";
+    str = new char[len + 2*strlen(quote) + 1];
+    sprintf(str, "%s%.*s%s", quote, len, s, quote);
+}
+
+void LoadStringConstant::Format() {
+    const char *quote = (strlen(str) > 50) ? "...\"" : "";
     sprintf(printed, "%s = %.50s%s", dst->GetName(), str, quote);
 }
 
-void LoadStringConstant::EmitSpecific(Mips *mips) {
-    mips->EmitLoadStringConstant(dst, str);
+void LoadStringConstant::EmitSpecific(Target *target) {
+    target->EmitLoadStringConstant(dst, str);
 }
 
 LoadLabel::LoadLabel(Location *d, const char *l)
-  : dst(d), label(strdup(l)) {
+  : dst(d), label(CopyString(l)) {
     Assert(dst != NULL && label != NULL);
+}
+
+void LoadLabel::Format() {
     sprintf(printed, "%s = %s", dst->GetName(), label);
 }
 
-void LoadLabel::EmitSpecific(Mips *mips) {
-    mips->EmitLoadLabel(dst, label);
+void LoadLabel::EmitSpecific(Target *target) {
+    target->EmitLoadLabel(dst, label);
 }
 
 
 Assign::Assign(Location *d, Location *s)
   : dst(d), src(s) {
     Assert(dst != NULL && src != NULL);
+}
+
+void Assign::Format() {
     sprintf(printed, "%s = %s", dst->GetName(), src->GetName());
 }
 
-void Assign::EmitSpecific(Mips *mips) {
-    mips->EmitCopy(dst, src);
+void Assign::EmitSpecific(Target *target) {
+    target->EmitCopy(dst, src);
 }
 
 Load::Load(Location *d, Location *s, int off)
   : dst(d), src(s), offset(off) {
     Assert(dst != NULL && src != NULL);
+}
+
+void Load::Format() {
     if (offset)
         sprintf(printed, "%s = *(%s + %d)", dst->GetName(), src->GetName(),
                 offset);
@@ -85,13 +111,16 @@ Load::Load(Location *d, Location *s, int off)
         sprintf(printed, "%s = *(%s)", dst->GetName(), src->GetName());
 }
 
-void Load::EmitSpecific(Mips *mips) {
-    mips->EmitLoad(dst, src, offset);
+void Load::EmitSpecific(Target *target) {
+    target->EmitLoad(dst, src, offset);
 }
 
 Store::Store(Location *d, Location *s, int off)
   : dst(d), src(s), offset(off) {
     Assert(dst != NULL && src != NULL);
+}
+
+void Store::Format() {
     if (offset)
         sprintf(printed, "*(%s + %d) = %s", dst->GetName(), offset,
                 src->GetName());
@@ -99,8 +128,8 @@ Store::Store(Location *d, Location *s, int off)
         sprintf(printed, "*(%s) = %s", dst->GetName(), src->GetName());
 }
 
-void Store::EmitSpecific(Mips *mips) {
-    mips->EmitStore(dst, src, offset);
+void Store::EmitSpecific(Target *target) {
+    target->EmitStore(dst, src, offset);
 }
 
 const char * const BinaryOp::opName[BinaryOp::NumOps] = {
@@ -121,129 +150,210 @@ BinaryOp::BinaryOp(OpCode c, Location *d, Location *o1, Location *o2)
   : code(c), dst(d), op1(o1), op2(o2) {
     Assert(dst != NULL && op1 != NULL && op2 != NULL);
     Assert(code >= 0 && code < NumOps);
+}
+
+void BinaryOp::Format() {
     sprintf(printed, "%s = %s %s %s", dst->GetName(), op1->GetName(),
             opName[code], op2->GetName());
 }
 
-void BinaryOp::EmitSpecific(Mips *mips) {
-    mips->EmitBinaryOp(code, dst, op1, op2);
+void BinaryOp::EmitSpecific(Target *target) {
+    target->EmitBinaryOp(code, dst, op1, op2);
 }
 
-Label::Label(const char *l) : label(strdup(l)) {
+/* The label text is kept, not copied, since the code generator renames
+ * the labels of a function when it appends the function, the same holds
+ * for Goto and IfZ.
+ */
+Label::Label(const char *l) : label(l) {
     Assert(label != NULL);
+}
+
+void Label::Format() {
     *printed = '\0';
 }
 
 void Label::Print() {
-    printf("%s:\n", label);
+    fprintf(ctx->out, "%s:\n", label);
 }
 
-void Label::EmitSpecific(Mips *mips) {
-    mips->EmitLabel(label);
+void Label::EmitSpecific(Target *target) {
+    target->EmitLabel(label);
 }
 
-Goto::Goto(const char *l) : label(strdup(l)) {
+Goto::Goto(const char *l) : label(l) {
     Assert(label != NULL);
+}
+
+void Goto::Format() {
     sprintf(printed, "Goto %s", label);
 }
 
-void Goto::EmitSpecific(Mips *mips) {
-    mips->EmitGoto(label);
+void Goto::EmitSpecific(Target *target) {
+    target->EmitGoto(label);
 }
 
-IfZ::IfZ(Location *te, const char *l)
-  : test(te), label(strdup(l)) {
+IfZ::IfZ(Location *te, const char *l, bool nz)
+  : test(te), label(l), ifNonZero(nz) {
     Assert(test != NULL && label != NULL);
-    sprintf(printed, "IfZ %s Goto %s", test->GetName(), label);
 }
 
-void IfZ::EmitSpecific(Mips *mips) {
-    mips->EmitIfZ(test, label);
+void IfZ::Format() {
+    sprintf(printed, "%s %s Goto %s", ifNonZero ? "IfNZ" : "IfZ",
+            test->GetName(), label);
+}
+
+void IfZ::EmitSpecific(Target *target) {
+    if (ifNonZero) target->EmitIfNZ(test, label);
+    else target->EmitIfZ(test, label);
 }
 
 BeginFunc::BeginFunc() {
-    sprintf(printed,"BeginFunc (unassigned)");
     frameSize = -555; // used as sentinel to recognized unassigned value
 }
 
 void BeginFunc::SetFrameSize(int numBytesForAllLocalsAndTemps) {
     frameSize = numBytesForAllLocalsAndTemps;
-    sprintf(printed,"BeginFunc %d", frameSize);
 }
 
-void BeginFunc::EmitSpecific(Mips *mips) {
-    mips->EmitBeginFunction(frameSize);
+void BeginFunc::Format() {
+    if (frameSize == -555)
+        sprintf(printed,"BeginFunc (unassigned)");
+    else
+        sprintf(printed,"BeginFunc %d", frameSize);
+}
+
+void BeginFunc::EmitSpecific(Target *target) {
+    target->EmitBeginFunction(frameSize);
 }
 
 EndFunc::EndFunc() : Instruction() {
+}
+
+void EndFunc::Format() {
     sprintf(printed, "EndFunc");
 }
 
-void EndFunc::EmitSpecific(Mips *mips) {
-    mips->EmitEndFunction();
+void EndFunc::EmitSpecific(Target *target) {
+    target->EmitEndFunction();
 }
 
 Return::Return(Location *v) : val(v) {
+}
+
+void Return::Format() {
     sprintf(printed, "Return %s", val? val->GetName() : "");
 }
 
-void Return::EmitSpecific(Mips *mips) {
-    mips->EmitReturn(val);
+void Return::EmitSpecific(Target *target) {
+    target->EmitReturn(val);
 }
 
 PushParam::PushParam(Location *p)
   : param(p) {
     Assert(param != NULL);
+}
+
+void PushParam::Format() {
     sprintf(printed, "PushParam %s", param->GetName());
 }
 
-void PushParam::EmitSpecific(Mips *mips) {
-    mips->EmitParam(param);
+void PushParam::EmitSpecific(Target *target) {
+    target->EmitParam(param);
 }
 
 PopParams::PopParams(int nb)
   : numBytes(nb) {
+}
+
+void PopParams::Format() {
     sprintf(printed, "PopParams %d", numBytes);
 }
 
-void PopParams::EmitSpecific(Mips *mips) {
-    mips->EmitPopParams(numBytes);
+void PopParams::EmitSpecific(Target *target) {
+    target->EmitPopParams(numBytes);
 }
 
 LCall::LCall(const char *l, Location *d)
-  : label(strdup(l)), dst(d) {
+  : label(CopyString(l)), dst(d) {
+}
+
+void LCall::Format() {
     sprintf(printed, "%s%sLCall %s", dst? dst->GetName(): "", dst?" = ":"",
             label);
 }
 
-void LCall::EmitSpecific(Mips *mips) {
-    mips->EmitLCall(dst, label);
+void LCall::EmitSpecific(Target *target) {
+    target->EmitLCall(dst, label);
 }
 
-ACall::ACall(Location *ma, Location *d)
-  : dst(d), methodAddr(ma) {
+ACall::ACall(Location *ma, Location *d, const char *s)
+  : dst(d), methodAddr(ma), selector(s ? CopyString(s) : NULL) {
     Assert(methodAddr != NULL);
+}
+
+void ACall::Format() {
     sprintf(printed, "%s%sACall %s", dst? dst->GetName(): "", dst?" = ":"",
             methodAddr->GetName());
 }
-void ACall::EmitSpecific(Mips *mips) {
-    mips->EmitACall(dst, methodAddr);
+void ACall::EmitSpecific(Target *target) {
+    target->EmitACall(dst, methodAddr);
 }
 
-VTable::VTable(const char *l, List<const char *> *m)
-  : methodLabels(m), label(strdup(l)) {
+VTable::VTable(const char *l, List<const char *> *m, List<const char *> *i)
+  : methodLabels(m), itableLabels(i), label(CopyString(l)) {
     Assert(methodLabels != NULL && label != NULL);
-    sprintf(printed, "VTable for class %s", l);
+}
+
+void VTable::Format() {
+    sprintf(printed, "VTable for class %s", label);
 }
 
 void VTable::Print() {
-    printf("VTable %s =\n", label);
+    fprintf(ctx->out, "VTable %s =\n", label);
+    for (int i = 0; i < methodLabels->NumElements(); i++)
+        fprintf(ctx->out, "\t%s,\n", methodLabels->Nth(i));
+    if (itableLabels) {
+        for (int i = 0; i < itableLabels->NumElements(); i++)
+            fprintf(ctx->out, "\tinterface %d: %s,\n", i,
+                    itableLabels->Nth(i) ? itableLabels->Nth(i) : "0");
+    }
+    fprintf(ctx->out, "; \n");
+}
+
+void VTable::EmitSpecific(Target *target) {
+    target->EmitVTable(label, methodLabels, itableLabels);
+}
+
+ITable::ITable(const char *l, List<const char *> *m)
+  : methodLabels(m), label(CopyString(l)) {
+    Assert(methodLabels != NULL && label != NULL);
+}
+
+void ITable::Format() {
+    sprintf(printed, "ITable %s", label);
+}
+
+void ITable::Print() {
+    fprintf(ctx->out, "ITable %s =\n", label);
     for (int i = 0; i < methodLabels->NumElements(); i++)
-        printf("\t%s,\n", methodLabels->Nth(i));
-    printf("; \n");
+        fprintf(ctx->out, "\t%s,\n", methodLabels->Nth(i));
+    fprintf(ctx->out, "; \n");
+}
+
+void ITable::EmitSpecific(Target *target) {
+    target->EmitITable(label, methodLabels);
 }
 
-void VTable::EmitSpecific(Mips *mips) {
-    mips->EmitVTable(label, methodLabels);
+
+ProfileTable::ProfileTable(const char *l, const char *f)
+  : label(CopyString(l)), function(CopyString(f)), numCounters(0) {
 }
 
+void ProfileTable::Format() {
+    sprintf(printed, "ProfileTable %s: %d", label, numCounters);
+}
+
+void ProfileTable::EmitSpecific(Target *target) {
+    target->EmitProfileTable(label, function, numCounters);
+}
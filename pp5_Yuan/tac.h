@@ -8,7 +8,8 @@
  * few fields, but each responds polymorphically to the methods
  * Print and Emit, the first is used to print out the TAC form of
  * the instruction (helpful when debugging) and the second to
- * convert to the appropriate MIPS assembly.
+ * convert to the code of the target, MIPS assembly by default (see
+ * target.h).
  *
  * The operands to each instruction are of Location class.
  * A Location object is a simple representation of where a variable
@@ -25,7 +26,7 @@
 
 #include "list.h" // for VTable
 
-class Mips;
+class Target;
 
 // A Location object is used to identify the operands to the
 // various TAC instructions. A Location is either fp or gp
@@ -53,6 +54,7 @@ class Location
     Segment GetSegment() const      { return segment; }
     int GetOffset() const           { return offset; }
     Location* GetBase() const       { return base; }
+    void SetName(const char *name);
 
     void Print();
 };
@@ -63,11 +65,13 @@ class Location
 class Instruction {
   protected:
     char printed[128];
+    // makes the printed form of the instruction.
+    virtual void Format() = 0;
 
   public:
     virtual void Print();
-    virtual void EmitSpecific(Mips *mips) = 0;
-    void Emit(Mips *mips);
+    virtual void EmitSpecific(Target *target) = 0;
+    void Emit(Target *target);
 };
 
 // for convenience, the instruction classes are listed here.
@@ -91,62 +95,72 @@ class PopParams;
 class LCall;
 class ACall;
 class VTable;
+class ITable;
+class ProfileTable;
 
 class LoadConstant: public Instruction
 {
     Location *dst;
     int val;
+    void Format();
   public:
     LoadConstant(Location *dst, int val);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class LoadStringConstant: public Instruction
 {
     Location *dst;
     char *str;
+    void Format();
   public:
-    LoadStringConstant(Location *dst, const char *s);
-    void EmitSpecific(Mips *mips);
+    LoadStringConstant(Location *dst, const char *s, int length = -1);
+    void EmitSpecific(Target *target);
 };
 
 class LoadLabel: public Instruction
 {
     Location *dst;
     const char *label;
+    void Format();
   public:
     LoadLabel(Location *dst, const char *label);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
+    const char* text() const { return label; }
 };
 
 class Assign: public Instruction
 {
     Location *dst, *src;
+    void Format();
   public:
     Assign(Location *dst, Location *src);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class Load: public Instruction
 {
     Location *dst, *src;
     int offset;
+    void Format();
   public:
     Load(Location *dst, Location *src, int offset = 0);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class Store: public Instruction
 {
     Location *dst, *src;
     int offset;
+    void Format();
   public:
     Store(Location *d, Location *s, int offset = 0);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class BinaryOp: public Instruction
 {
+    void Format();
   public:
     typedef enum {
         Add, Sub, Mul, Div, Mod,
@@ -162,104 +176,156 @@ class BinaryOp: public Instruction
     Location *dst, *op1, *op2;
   public:
     BinaryOp(OpCode c, Location *dst, Location *op1, Location *op2);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class Label: public Instruction
 {
     const char *label;
+    void Format();
   public:
     Label(const char *label);
     void Print();
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
     const char* text() const { return label; }
 };
 
 class Goto: public Instruction
 {
     const char *label;
+    void Format();
   public:
     Goto(const char *label);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
     const char* branch_label() const { return label; }
 };
 
+// branches if test is zero, or if it is not zero with ifNonZero, which
+// is made by the block layout, see CodeGenerator::LayoutBlocks.
 class IfZ: public Instruction
 {
     Location *test;
     const char *label;
+    bool ifNonZero;
+    void Format();
   public:
-    IfZ(Location *test, const char *label);
-    void EmitSpecific(Mips *mips);
+    IfZ(Location *test, const char *label, bool ifNonZero = false);
+    void EmitSpecific(Target *target);
     const char* branch_label() const { return label; }
+    Location *test_var() const { return test; }
+    bool if_nonzero() const { return ifNonZero; }
 };
 
 class BeginFunc: public Instruction
 {
     int frameSize;
+    void Format();
   public:
     BeginFunc();
     // used to backpatch the instruction with frame size once known
     void SetFrameSize(int numBytesForAllLocalsAndTemps);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class EndFunc: public Instruction
 {
+    void Format();
   public:
     EndFunc();
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class Return: public Instruction
 {
     Location *val;
+    void Format();
   public:
     Return(Location *val);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class PushParam: public Instruction
 {
     Location *param;
+    void Format();
   public:
     PushParam(Location *param);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class PopParams: public Instruction
 {
     int numBytes;
+    void Format();
   public:
     PopParams(int numBytesOfParamsToRemove);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
 };
 
 class LCall: public Instruction
 {
     const char *label;
     Location *dst;
+    void Format();
   public:
     LCall(const char *labe, Location *result);
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
+    const char* callee() const { return label; }
 };
 
 class ACall: public Instruction
 {
     Location *dst, *methodAddr;
+    const char *selector; // the method name, NULL if unknown.
+    void Format();
   public:
-    ACall(Location *meth, Location *result);
-    void EmitSpecific(Mips *mips);
+    ACall(Location *meth, Location *result, const char *selector = NULL);
+    void EmitSpecific(Target *target);
+    const char* method_name() const { return selector; }
 };
 
 class VTable: public Instruction
+{
+    List<const char *> *methodLabels;
+    List<const char *> *itableLabels;
+    const char *label;
+    void Format();
+ public:
+    VTable(const char *labelForTable, List<const char *> *methodLabels,
+           List<const char *> *itableLabels = NULL);
+    void Print();
+    void EmitSpecific(Target *target);
+    const char* text() const { return label; }
+    List<const char *> *methods() const { return methodLabels; }
+    List<const char *> *itables() const { return itableLabels; }
+};
+
+class ITable: public Instruction
 {
     List<const char *> *methodLabels;
     const char *label;
+    void Format();
  public:
-    VTable(const char *labelForTable, List<const char *> *methodLabels);
+    ITable(const char *labelForTable, List<const char *> *methodLabels);
     void Print();
-    void EmitSpecific(Mips *mips);
+    void EmitSpecific(Target *target);
+    const char* text() const { return label; }
+    List<const char *> *methods() const { return methodLabels; }
+};
+
+// the profile counters of a function, see CodeGenerator::Instrument.
+class ProfileTable: public Instruction
+{
+    const char *label;
+    const char *function;
+    int numCounters;
+    void Format();
+ public:
+    ProfileTable(const char *labelForTable, const char *function);
+    // used to backpatch the number of counters once known
+    void SetNumCounters(int n) { numCounters = n; }
+    void EmitSpecific(Target *target);
+    const char* text() const { return label; }
 };
 
 #endif
@@ -0,0 +1,39 @@
+/* File: target.cc
+ * ---------------
+ * Implementation of the Target helpers.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "target.h"
+#include <stdarg.h>
+#include <string.h>
+#include "mips.h"
+#include "x86.h"
+#include "context.h"
+
+Target * Target::New(const char *name) {
+    if (!strcmp(name, "mips")) return new Mips();
+    if (!strcmp(name, "x86-64")) return new X86();
+    return NULL;
+}
+
+/* Method: Emit
+ * ------------
+ * General purpose helper used to emit assembly instructions in
+ * a reasonable tidy manner.  Takes printf-style formatting strings
+ * and variable arguments.
+ */
+void Target::Emit(const char *fmt, ...) {
+    va_list args;
+    char buf[1024];
+
+    va_start(args, fmt);
+    vsprintf(buf, fmt, args);
+    va_end(args);
+    FILE *out = ctx->out;
+    if (buf[strlen(buf) - 1] != ':') fprintf(out, "\t"); // don't tab in labels
+    if (buf[0] != '#') fprintf(out, "  ");   // outdent comments a little
+    fprintf(out, "%s", buf);
+    if (buf[strlen(buf)-1] != '\n') fprintf(out, "\n"); // end with a newline
+}
@@ -0,0 +1,83 @@
+/* File: target.h
+ * --------------
+ * The Target class is the interface of the final code generators. Each
+ * Tac instruction emits itself into a Target with one of the methods
+ * below, see Instruction::EmitSpecific. The targets are:
+ *
+ *    mips      the MIPS assembly for spim, the default (see mips.h).
+ *    x86-64    the x86-64 assembly for the GNU assembler, with the System
+ *              V calling convention for the built-in functions (see
+ *              x86.h).
+ *
+ * and the interpreter, which lowers the Tac into bytecode (see interp.h).
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_target
+#define _H_target
+
+#include "tac.h"
+#include "list.h"
+
+class Location;
+
+class Target
+{
+  protected:
+    // emits a line of assembly, labels are not indented.
+    static void Emit(const char *fmt, ...);
+
+  public:
+    virtual ~Target() {}
+
+    // makes the assembly target of the given name (see above), or returns
+    // NULL if there is none.
+    static Target * New(const char *name);
+
+    // the printed form of the Tac instruction about to be emitted, which
+    // the assembly targets emit as a comment.
+    virtual void EmitComment(const char *tac) {}
+
+    virtual void EmitLoadConstant(Location *dst, int val) = 0;
+    virtual void EmitLoadStringConstant(Location *dst, const char *str) = 0;
+    virtual void EmitLoadLabel(Location *dst, const char *label) = 0;
+
+    virtual void EmitLoad(Location *dst, Location *reference, int offset) = 0;
+    virtual void EmitStore(Location *reference, Location *value,
+                           int offset) = 0;
+    virtual void EmitCopy(Location *dst, Location *src) = 0;
+
+    virtual void EmitBinaryOp(BinaryOp::OpCode code, Location *dst,
+            Location *op1, Location *op2) = 0;
+
+    virtual void EmitLabel(const char *label) = 0;
+    virtual void EmitGoto(const char *label) = 0;
+    virtual void EmitIfZ(Location *test, const char*label) = 0;
+    virtual void EmitIfNZ(Location *test, const char*label) = 0;
+    virtual void EmitReturn(Location *returnVal) = 0;
+
+    virtual void EmitBeginFunction(int frameSize) = 0;
+    virtual void EmitEndFunction() = 0;
+
+    virtual void EmitParam(Location *arg) = 0;
+    virtual void EmitLCall(Location *result, const char* label) = 0;
+    virtual void EmitACall(Location *result, Location *fnAddr) = 0;
+    virtual void EmitPopParams(int bytes) = 0;
+
+    virtual void EmitVTable(const char *label,
+                            List<const char*> *methodLabels,
+                            List<const char*> *itableLabels = NULL) = 0;
+    virtual void EmitITable(const char *label,
+                            List<const char*> *methodLabels) = 0;
+    // a table of profile counters: the address of the function name, the
+    // number of counters, and the counters, all 0.
+    virtual void EmitProfileTable(const char *label, const char *function,
+                                  int numCounters) = 0;
+
+    // the start and the end of the program.
+    virtual void EmitPreamble() {}
+    virtual void EmitEpilogue() {}
+};
+
+#endif
@@ -0,0 +1,71 @@
+/* File: trace.cc
+ * --------------
+ * Implementation of TraceBuffer.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "trace.h"
+#include <stdarg.h>
+#include <string.h>
+#include "context.h"
+
+std::atomic<unsigned> TraceBuffer::categories(0);
+
+// the debug key of each category.
+static const char *CategoryKeys[NumTraceCategories] = {
+    "lex", "parser", "ast+", "sttrace", "tac+", "dce", "layout"
+};
+
+TraceBuffer::TraceBuffer() : records(Size), next(0) {
+}
+
+void TraceBuffer::Enable(CompilationContext *c) {
+    unsigned mask = 0;
+    for (int i = 0; i < c->debugKeys->NumElements(); i++) {
+        for (int k = 0; k < NumTraceCategories; k++)
+            if (!strcmp(c->debugKeys->Nth(i), CategoryKeys[k]))
+                mask |= 1u << k;
+    }
+    c->traceMask = mask;
+    if (!mask) return;
+    if (!c->trace) c->trace = new TraceBuffer;
+    categories.fetch_or(mask, std::memory_order_relaxed);
+}
+
+void TraceBuffer::Add(TraceCategory category, const char *file, int line,
+                      const char *format, ...) {
+    if (!ctx || !(ctx->traceMask & (1u << category))) return;
+    // the message is formatted before the lock is taken.
+    char text[sizeof(((Record *)0)->text)];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    TraceBuffer *t = ctx->trace;
+    std::lock_guard<std::mutex> guard(t->lock);
+    unsigned long seq = t->next++;
+    Record &r = t->records[seq % Size];
+    r.seq = seq;
+    r.category = category;
+    r.file = file;
+    r.line = line;
+    memcpy(r.text, text, sizeof(text));
+}
+
+void TraceBuffer::Dump(FILE *f) {
+    std::lock_guard<std::mutex> guard(lock);
+    unsigned long end = next, begin = 0;
+    next = 0;
+    if (end > (unsigned long)Size) {
+        begin = end - Size;
+        fprintf(f, "+++ (trace): %lu older records dropped.\n", begin);
+    }
+    for (unsigned long seq = begin; seq < end; seq++) {
+        Record &r = records[seq % Size];
+        size_t n = strlen(r.text);
+        fprintf(f, "+++ (%s) %s:%d: %s%s", CategoryKeys[r.category], r.file,
+                r.line, r.text, n == 0 || r.text[n - 1] != '\n' ? "\n" : "");
+    }
+}
@@ -0,0 +1,89 @@
+/* File: trace.h
+ * -------------
+ * The trace of the compiler. A trace point names a category and gives
+ * printf arguments:
+ *
+ *    Trace(T_SymbolTable, "Lookup %s in scope %d.", key, cur_scope);
+ *
+ * A category is turned on for a compilation by its debug key (-d <key>):
+ * lex, parser, ast+ (the check passes), sttrace (the symbol table), tac+
+ * (the emission of the Tac), dce (RemoveUnreachableCode) and layout (of
+ * the classes). The other debug keys, such as tac or ast, change what is
+ * printed rather than trace, see IsDebugOn.
+ *
+ * A trace point costs one test of a global mask when its category is off
+ * in every compilation, and nothing at all when the compiler is built
+ * with -DNO_TRACE (make TRACE=-DNO_TRACE). When it is on, a record of
+ * the category, the source position and the message is added to the
+ * TraceBuffer of the compilation, a ring which keeps the last records,
+ * behind a lock since the threads of a compilation share it. The ring is
+ * printed on the output of the compilation when it ends, and on the error
+ * output by Failure, so a failed Assert shows what led to it.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_trace
+#define _H_trace
+
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+typedef enum {
+    T_Lex, T_Parser, T_Passes, T_SymbolTable, T_Emit, T_Dce, T_Layout,
+    NumTraceCategories
+} TraceCategory;
+
+class CompilationContext;
+
+class TraceBuffer
+{
+  protected:
+    struct Record {
+        unsigned long seq;
+        TraceCategory category;
+        const char *file;
+        int line;
+        char text[120];
+    };
+
+    static const int Size = 4096;   // the records kept.
+    std::vector<Record> records;
+    unsigned long next;             // the records added.
+    // taken by Add and Dump, the emission threads add records together,
+    // and Failure may dump while others still add.
+    std::mutex lock;
+
+  public:
+    // the categories on in any compilation.
+    static std::atomic<unsigned> categories;
+
+    TraceBuffer();
+
+    // turns on the categories of the debug keys of the compilation, with
+    // a buffer if it has none.
+    static void Enable(CompilationContext *c);
+
+    // adds a record for the compilation of the current thread, if the
+    // category is on in it. Thread-safe.
+    static void Add(TraceCategory category, const char *file, int line,
+                    const char *format, ...)
+        __attribute__((format(printf, 4, 5)));
+
+    // prints the records kept, the oldest first, and empties the ring.
+    // Thread-safe.
+    void Dump(FILE *f);
+};
+
+#ifdef NO_TRACE
+#define Trace(category, ...) ((void)0)
+#else
+#define Trace(category, ...)                                              \
+    ((TraceBuffer::categories.load(std::memory_order_relaxed) &           \
+      (1u << (category))) ?                                               \
+     TraceBuffer::Add(category, __FILE__, __LINE__, __VA_ARGS__) : (void)0)
+#endif
+
+#endif
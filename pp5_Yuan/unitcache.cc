@@ -0,0 +1,152 @@
+/* File: unitcache.cc
+ * ------------------
+ * Implementation of UnitCache.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "unitcache.h"
+#include <stdio.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "arena.h"
+#include "ast_decl.h"
+#include "context.h"
+#include "scanner.h"
+
+UnitCache::UnitCache(int c, size_t b) {
+    capacity = c;
+    maxBytes = b;
+    clock = 0;
+    hits = misses = 0;
+}
+
+/*
+ * FNV-1a, the hash of the environment is folded over its pieces.
+ */
+static uint64_t Hash(uint64_t h, const char *s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void UnitCache::Begin(List<FnDecl*> *fns) {
+    // the cache outlives the arena of the compilation.
+    Arena::Suspend suspend;
+    clock++;
+    hits = misses = 0;
+    keys.clear();
+    found.clear();
+
+    // the span of each body, from '{' to '}'.
+    std::vector<std::pair<long, long> > spans;
+    std::vector<FnDecl*> owners;
+    for (int i = 0; i < fns->NumElements(); i++) {
+        yyltype *loc = fns->Nth(i)->GetBodyLocation();
+        if (!loc) continue;
+        long start = GetInputOffset(loc->first_line, loc->first_column);
+        long end = GetInputOffset(loc->last_line, loc->last_column);
+        if (start < 0 || end < start) continue; // not cached.
+        spans.push_back(std::make_pair(start, end + 1));
+        owners.push_back(fns->Nth(i));
+    }
+
+    // the environment is the input without the bodies.
+    std::vector<std::pair<long, long> > sorted(spans);
+    std::sort(sorted.begin(), sorted.end());
+    uint64_t env = 14695981039346656037ULL;
+    long pos = 0;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        env = Hash(env, ctx->input + pos, sorted[i].first - pos);
+        pos = sorted[i].second;
+    }
+    env = Hash(env, ctx->input + pos, ctx->inputSize - pos);
+
+    for (size_t i = 0; i < owners.size(); i++) {
+        FnDecl *fn = owners[i];
+        Decl *owner = dynamic_cast<Decl*>(fn->GetParent());
+        char envHex[20];
+        sprintf(envHex, "%016llx ", (unsigned long long)env);
+        std::string key(envHex);
+        if (owner && owner->IsClassDecl())
+            key += std::string(owner->GetId()->GetIdName()) + ".";
+        key += fn->GetId()->GetIdName();
+        key += '\n';
+        key.append(ctx->input + spans[i].first,
+                   spans[i].second - spans[i].first);
+        keys[fn] = key;
+
+        std::map<std::string, Entry*>::iterator e = entries.find(key);
+        if (e != entries.end()) {
+            e->second->lastUsed = clock;
+            found[fn] = e->second->code;
+            hits++;
+        } else {
+            misses++;
+        }
+    }
+}
+
+CodeGenerator *UnitCache::Lookup(FnDecl *fn) {
+    std::map<FnDecl*, CodeGenerator*>::iterator f = found.find(fn);
+    return f == found.end() ? NULL : f->second;
+}
+
+void UnitCache::Store(FnDecl *fn, CodeGenerator *code) {
+    Arena *arena = Arena::current;
+    Arena::Suspend suspend;
+    std::map<FnDecl*, std::string>::iterator k = keys.find(fn);
+    if (k == keys.end() || !arena) return;
+
+    std::map<std::string, Entry*>::iterator e = entries.find(k->second);
+    if (e != entries.end()) Drop(e);
+    Entry *entry = new Entry;
+    entry->code = code;
+    entry->arena = arena;
+    entry->lastUsed = clock;
+    entries[k->second] = entry;
+    if (arenas[arena]++ == 0) arena->Retain();
+}
+
+/*
+ * Drop an entry, and release its arena with the last entry in it.
+ */
+void UnitCache::Drop(std::map<std::string, Entry*>::iterator e) {
+    Arena *arena = e->second->arena;
+    delete e->second;
+    entries.erase(e);
+    if (--arenas[arena] == 0) {
+        arenas.erase(arena);
+        arena->Release();
+    }
+}
+
+/*
+ * Drop the least recently used entries until the cache fits. The code
+ * found in the cache is used until the compilation ends, so no entry is
+ * dropped before. The functions of the last compilation are kept over the
+ * bound of the arenas, it is a single program larger than the bound.
+ */
+void UnitCache::End() {
+    Arena::Suspend suspend;
+    keys.clear();
+    found.clear();
+    size_t bytes = 0;
+    std::map<Arena*, int>::iterator a;
+    for (a = arenas.begin(); a != arenas.end(); ++a) bytes += a->first->Size();
+
+    while ((int)entries.size() > capacity || bytes > maxBytes) {
+        std::map<std::string, Entry*>::iterator e, lru = entries.begin();
+        for (e = entries.begin(); e != entries.end(); ++e) {
+            if (e->second->lastUsed < lru->second->lastUsed) lru = e;
+        }
+        if ((int)entries.size() <= capacity && lru->second->lastUsed == clock)
+            break;
+        Arena *arena = lru->second->arena;
+        if (arenas[arena] == 1) bytes -= arena->Size();
+        Drop(lru);
+    }
+}
@@ -0,0 +1,82 @@
+/* File: unitcache.h
+ * -----------------
+ * The UnitCache keeps the code of the functions and methods from one
+ * compilation to the next, for the compile server (see server.h).
+ *
+ * The check and the code of a body depend on nothing but the body and the
+ * declarations of the program. So a function is found in the cache by a
+ * hash of its environment, which is the whole input with the text of all
+ * the function bodies cut out, and by the name of its class, its own name
+ * and the exact text of its body. Thus an edit inside a body only misses
+ * the function edited, while an edit anywhere else (a field, a signature,
+ * a class) misses them all. The functions of several programs are cached
+ * side by side. A function found in the cache is neither checked nor
+ * emitted, its code is copied from the cache and appended in its place,
+ * see CodeGenerator::EmitUnits.
+ *
+ * Only the code of programs without errors is kept, so a function found
+ * in the cache has no errors either. The code of a function lives in the
+ * Arena of its compilation (see arena.h), which the cache holds as long
+ * as it holds the function. The cache holds a bounded number of functions
+ * and a bounded size of arenas, the least recently used functions are
+ * dropped first, after each compilation.
+ *
+ * The cache serves one compilation at a time.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_unitcache
+#define _H_unitcache
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include "list.h"
+
+class FnDecl;
+class CodeGenerator;
+class Arena;
+
+class UnitCache
+{
+  protected:
+    struct Entry {
+        CodeGenerator *code;
+        Arena *arena;               // of the code.
+        long lastUsed;              // the compilation that last used it.
+    };
+    std::map<std::string, Entry*> entries;
+    std::map<Arena*, int> arenas;   // the entries of each arena held.
+    int capacity;
+    size_t maxBytes;                // of the arenas held.
+    long clock;                     // the number of compilations so far.
+    int hits, misses;               // of the last compilation.
+
+    // the state of the current compilation, see Begin.
+    std::map<FnDecl*, std::string> keys;
+    std::map<FnDecl*, CodeGenerator*> found;
+
+    void Drop(std::map<std::string, Entry*>::iterator e);
+
+  public:
+    // constructor, for at most capacity functions in arenas of at most
+    // maxBytes.
+    UnitCache(int capacity, size_t maxBytes);
+    // called with the function bodies of the program before they are
+    // checked, finds them in the cache.
+    void Begin(List<FnDecl*> *fns);
+    // the cached code of the function, or NULL if it was not found and
+    // must be checked and emitted.
+    CodeGenerator * Lookup(FnDecl *fn);
+    // keeps the code of a function, when the program has no errors. The
+    // code is in the arena of the current thread.
+    void Store(FnDecl *fn, CodeGenerator *code);
+    // called after the compilation, drops the functions over the bounds
+    // and releases the arenas no function is left in.
+    void End();
+    int NumHits() { return hits; }
+    int NumMisses() { return misses; }
+};
+
+#endif
@@ -7,9 +7,18 @@
 #include "utility.h"
 #include <stdarg.h>
 #include "list.h"
+#include "context.h"
+#include "target.h"
+#include "profile.h"
+#include "stats.h"
+#include "trace.h"
+#include "arena.h"
 #include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
-static List<const char*> debugKeys;
 static const int BufferSize = 2048;
 
 void Failure(const char *format, ...) {
@@ -21,50 +30,150 @@ void Failure(const char *format, ...) {
     va_end(args);
     fflush(stdout);
     fprintf(stderr,"\n*** Failure: %s\n\n", errbuf);
+    if (ctx && ctx->trace) {
+        fprintf(stderr, "*** Trace:\n");
+        ctx->trace->Dump(stderr);
+    }
     abort();
 }
 
-int IndexOf(const char *key) {
-    for (int i = 0; i < debugKeys.NumElements(); i++)
-        if (!strcmp(debugKeys.Nth(i), key)) return i;
+char *CopyString(const char *s) {
+    size_t n = strlen(s) + 1;
+    return (char *)memcpy(new char[n], s, n);
+}
+
+void ParallelFor(int n, int numThreads,
+                 const std::function<void(int)> &body) {
+    std::atomic<int> next(0);
+    Arena *arena = Arena::current;
+    auto work = [&]() {
+        Arena::current = arena;
+        for (int i = next++; i < n; i = next++)
+            body(i);
+    };
+    std::vector<std::thread> workers;
+    for (int i = 1; i < numThreads && i < n; i++)
+        workers.push_back(std::thread(work));
+    work();
+    for (int i = 0; i < (int)workers.size(); i++)
+        workers[i].join();
+}
+
+int IndexOf(List<const char*> *debugKeys, const char *key) {
+    for (int i = 0; i < debugKeys->NumElements(); i++)
+        if (!strcmp(debugKeys->Nth(i), key)) return i;
     return -1;
 }
 
 bool IsDebugOn(const char *key) {
-    return (IndexOf(key) != -1);
+    return ctx && (IndexOf(ctx->debugKeys, key) != -1);
 }
 
 void SetDebugForKey(const char *key, bool value) {
-    int k = IndexOf(key);
+    Assert(ctx != NULL);
+    int k = IndexOf(ctx->debugKeys, key);
     if (!value && k != -1)
-        debugKeys.RemoveAt(k);
+        ctx->debugKeys->RemoveAt(k);
     else if (value && k == -1)
-        debugKeys.Append(key);
+        ctx->debugKeys->Append(key);
+    TraceBuffer::Enable(ctx);
 }
 
-void PrintDebug(const char *key, const char *format, ...) {
-    va_list args;
-    char buf[BufferSize];
-
-    if (!IsDebugOn(key))
-        return;
-
-    va_start(args, format);
-    vsprintf(buf, format, args);
-    va_end(args);
-    printf("+++ (%s): %s%s", key, buf, buf[strlen(buf)-1] != '\n'? "\n" : "");
+static void Usage() {
+    printf("Usage:   [<file>] [-j <threads>] [--target mips|x86-64] "
+           "[--instrument] [--profile-use <file>] [--run] "
+           "[--emit-bytecode <file>] "
+           "[--emit-summary <file>] [--import <file> ...] "
+           "[--cache-dir <dir>] [--cache-size <megabytes>] "
+           "[--time-report] [--stats] [--report-json <file>] "
+           "-d <debug-key-1> <debug-key-2> ... \n");
+    exit(2);
 }
 
-void ParseCommandLine(int argc, char *argv[]) {
+void ParseCommandLine(int argc, char *argv[], CompilationContext *c) {
+    // one code generation thread per core by default.
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    c->numThreads = cores > 0 ? cores : 1;
     if (argc == 1)
         return;
 
-    if (strcmp(argv[1], "-d") != 0) { // first arg is not -d
-        printf("Usage:   -d <debug-key-1> <debug-key-2> ... \n");
-        exit(2);
+    int i = 1;
+    if (argv[i][0] != '-') // first arg is the input file
+        c->inputFile = argv[i++];
+    bool timeReport = false, counts = false;
+    while (i < argc && strcmp(argv[i], "-d") != 0) {
+        if (strcmp(argv[i], "-j") == 0) {
+            if (++i == argc || (c->numThreads = atoi(argv[i++])) <= 0)
+                Usage();
+        } else if (strcmp(argv[i], "--target") == 0) {
+            if (++i == argc) Usage();
+            Target *target = Target::New(argv[i]);
+            if (!target) Usage();
+            delete target;
+            c->targetName = argv[i++];
+        } else if (strcmp(argv[i], "--instrument") == 0) {
+            c->instrument = true;
+            i++;
+        } else if (strcmp(argv[i], "--profile-use") == 0) {
+            if (++i == argc) Usage();
+            c->profile = new Profile;
+            if (!c->profile->Read(argv[i])) {
+                printf("Cannot read the profile %s.\n", argv[i]);
+                exit(2);
+            }
+            i++;
+        } else if (strcmp(argv[i], "--run") == 0) {
+            c->run = true;
+            i++;
+        } else if (strcmp(argv[i], "--emit-bytecode") == 0) {
+            if (++i == argc) Usage();
+            c->bytecodeFile = argv[i++];
+        } else if (strcmp(argv[i], "--emit-summary") == 0) {
+            if (++i == argc) Usage();
+            c->summaryFile = argv[i++];
+        } else if (strcmp(argv[i], "--import") == 0) {
+            if (++i == argc) Usage();
+            c->imports->Append(argv[i++]);
+        } else if (strcmp(argv[i], "--cache-dir") == 0) {
+            if (++i == argc) Usage();
+            c->cacheDir = argv[i++];
+        } else if (strcmp(argv[i], "--cache-size") == 0) {
+            if (++i == argc || (c->cacheSize = atol(argv[i++])) <= 0)
+                Usage();
+            c->cacheSize <<= 20;
+        } else if (strcmp(argv[i], "--time-report") == 0) {
+            timeReport = true;
+            i++;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            counts = true;
+            i++;
+        } else if (strcmp(argv[i], "--report-json") == 0) {
+            if (++i == argc) Usage();
+            c->reportFile = argv[i++];
+        } else {
+            Usage();
+        }
     }
+    // --report-json alone writes the whole report.
+    if (c->reportFile && !timeReport && !counts)
+        timeReport = counts = true;
+    if (timeReport || counts)
+        c->stats = new Stats(timeReport, counts);
+    // the code of a library is assembly, which cannot be run.
+    if ((c->run || c->bytecodeFile) &&
+        (c->summaryFile || c->imports->NumElements() > 0))
+        Usage();
+    // the profile covers the code of a whole program.
+    if ((c->instrument || c->profile) &&
+        (c->summaryFile || c->imports->NumElements() > 0))
+        Usage();
+    // the counters are numbered in the code before its layout.
+    if (c->instrument && c->profile)
+        Usage();
+    if (i == argc)
+        return;
 
-    for (int i = 2; i < argc; i++)
-        SetDebugForKey(argv[i], true);
+    for (i++; i < argc; i++)
+        c->debugKeys->Append(argv[i]);
 }
 
@@ -9,6 +9,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <functional>
 
 /* Function: Failure()
  * Usage: Failure("Out of memory!");
@@ -36,23 +37,31 @@ void Failure(const char *format, ...);
   ((expr) ? (void)0 : Failure("Assertion failed: %s, line %d:\n    %s", \
       __FILE__, __LINE__, #expr))
 
-/* Function: PrintDebug()
- * Usage: PrintDebug("parser", "found ident %s\n", ident);
- * -------------------------------------------------------
- * Print a message if we have turned debugging messages on for the given
- * key.  For example, the usage line shown above will only print a message
- * if the call is preceded by a call to SetDebugForKey("parser",true).
- * The function accepts printf arguments.  The provided main.cc parses
- * the command line to turn on debug flags.
+/* Function: CopyString()
+ * Usage: name = CopyString(n);
+ * ----------------------------
+ * Returns a copy of the string allocated with new[], unlike strdup, so it
+ * is freed with the arena of a compilation, see arena.h.
  */
-void PrintDebug(const char *key, const char *format, ...);
+char *CopyString(const char *s);
+
+/* Function: ParallelFor()
+ * Usage: ParallelFor(n, numThreads, [&](int i) { ... });
+ * -----------------------------------------------------
+ * Runs the body for each i from 0 to n-1, on at most numThreads threads
+ * (the calling thread is one of them), and returns when all are done.
+ * The order in which the body runs for different i is not specified.
+ * The workers allocate from the arena of the calling thread, see arena.h.
+ */
+void ParallelFor(int n, int numThreads, const std::function<void(int)> &body);
 
 /* Function: SetDebugForKey()
  * Usage: SetDebugForKey("scope", true);
  * -------------------------------------
- * Turn on debugging messages for the given key.  See PrintDebug
- * for an example. Can be called manually when desired and will
- * be called from the provided main for flags passed with -d.
+ * Turn on debugging messages for the given key in the compilation
+ * running on this thread, the keys of the trace categories turn them on,
+ * see trace.h. Can be called manually when desired, the flags passed
+ * with -d are set when the compilation starts.
  */
 void SetDebugForKey(const char *key, bool val);
 
@@ -60,17 +69,35 @@ void SetDebugForKey(const char *key, bool val);
  * Usage: if (IsDebugOn("scope")) ...
  * ----------------------------------
  * Return true/false based on whether this key is currently on
- * for debug printing.
+ * for debug printing. The trace points test their category instead,
+ * see trace.h.
  */
 bool IsDebugOn(const char *key);
 
 /* Function: ParseCommandLine
  * --------------------------
- * Turn on the debugging flags from the command line.  Verifies that
- * first argument is -d, and then interpret all the arguments that follow
- * as being flags to turn on.
+ * Parse the command line into the given compilation context:
+ * dcc [<file>] [-j <threads>] [--target <name>] [--instrument]
+ * [--profile-use <file>] [--run] [--emit-bytecode <file>]
+ * [--emit-summary <file>] [--import <file>] [--cache-dir <dir>]
+ * [--cache-size <mb>] [--time-report] [--stats] [--report-json <file>]
+ * [-d <debug-key-1> ...]. An optional first argument names the input
+ * file, otherwise the input is read from stdin. The code is generated on
+ * the given number of threads, one per core by default, for the given
+ * target, MIPS by default, see target.h. With --instrument, the code
+ * counts the runs of its functions and blocks and prints them at the
+ * end, see CodeGenerator::Instrument, and with --profile-use the blocks
+ * are laid out by such a profile, see CodeGenerator::LayoutBlocks. With
+ * --run, the program is run instead, and with --emit-bytecode it is
+ * written as bytecode, see interp.h. A library is compiled with the
+ * summary of its declarations, and imported by a program, see summary.h.
+ * The results are cached in the given directory, see diskcache.h. With
+ * --time-report and --stats, the time and memory of the phases and some
+ * counts are reported after the compilation, see stats.h. All the
+ * arguments that follow -d are interpreted as being flags to turn on.
  */
-void ParseCommandLine(int argc, char *argv[]);
+class CompilationContext;
+void ParseCommandLine(int argc, char *argv[], CompilationContext *c);
 
 #endif
 
@@ -0,0 +1,268 @@
+/* File: x86.cc
+ * ------------
+ * Implementation of the X86 class, which translates Tac to x86-64
+ * assembly in the way of the Mips class: each operand is loaded from
+ * memory and each result is stored back, with %eax and %ecx.
+ *
+ * Author: Deyuan Guo
+ */
+
+#include "x86.h"
+#include <stdio.h>
+#include <string.h>
+#include "codegen.h"
+#include "context.h"
+
+X86::X86() {
+    globalSize = 0;
+}
+
+/* Method: Var
+ * -----------
+ * The memory operand of a var. The params are above the return address
+ * and the saved %rbp, so their offsets are shifted by 12 bytes from the
+ * ones of MIPS, where the first param is at fp+4. The locals stay below
+ * %rbp at their offsets.
+ */
+std::string X86::Var(Location *var) {
+    Assert(var && var->GetOffset() % 4 == 0);
+    char buf[64];
+    int offset = var->GetOffset();
+    if (var->GetSegment() == fpRelative) {
+        sprintf(buf, "%d(%%rbp)", offset > 0 ? offset + 12 : offset);
+    } else {
+        if (offset + CodeGenerator::VarSize > globalSize)
+            globalSize = offset + CodeGenerator::VarSize;
+        sprintf(buf, "decaf_globals+%d(%%rip)", offset);
+    }
+    return buf;
+}
+
+/* The main function of Decaf is called by the main of the runtime.
+ */
+const char *X86::Symbol(const char *label) {
+    return strcmp(label, "main") ? label : "decaf_main";
+}
+
+void X86::EmitComment(const char *tac) {
+    Emit("# %s", tac);
+}
+
+void X86::EmitLoadConstant(Location *dst, int val) {
+    Emit("movl $%d, %s\t# load constant value %d", val, Var(dst).c_str(),
+            val);
+}
+
+void X86::EmitLoadStringConstant(Location *dst, const char *str) {
+    char label[48];
+    sprintf(label, "_%sstring%d", ctx->labelPrefix, ctx->nextStrNum++);
+    Emit(".data\t\t\t# create string constant marked with label");
+    Emit("%s: .asciz %s", label, str);
+    Emit(".text");
+    EmitLoadLabel(dst, label);
+}
+
+void X86::EmitLoadLabel(Location *dst, const char *label) {
+    Emit("movl $%s, %%eax\t# load label", Symbol(label));
+    Emit("movl %%eax, %s", Var(dst).c_str());
+}
+
+void X86::EmitCopy(Location *dst, Location *src) {
+    Emit("movl %s, %%eax", Var(src).c_str());
+    Emit("movl %%eax, %s", Var(dst).c_str());
+}
+
+void X86::EmitLoad(Location *dst, Location *reference, int offset) {
+    Emit("movl %s, %%ecx", Var(reference).c_str());
+    Emit("movl %d(%%rcx), %%eax\t# load with offset", offset);
+    Emit("movl %%eax, %s", Var(dst).c_str());
+}
+
+void X86::EmitStore(Location *reference, Location *value, int offset) {
+    Emit("movl %s, %%eax", Var(value).c_str());
+    Emit("movl %s, %%ecx", Var(reference).c_str());
+    Emit("movl %%eax, %d(%%rcx)\t# store with offset", offset);
+}
+
+/* The set instructions of the comparisons, in the order of OpCode.
+ */
+const char * const X86::compareName[BinaryOp::NumOps] = {
+    NULL, NULL, NULL, NULL, NULL,
+    "sete", "setne", "setl", "setle", "setg", "setge",
+    NULL, NULL
+};
+
+void X86::EmitBinaryOp(BinaryOp::OpCode code, Location *dst,
+        Location *op1, Location *op2)
+{
+    std::string a = Var(op1), b = Var(op2);
+    Emit("movl %s, %%eax", a.c_str());
+    switch (code) {
+      case BinaryOp::Add: Emit("addl %s, %%eax", b.c_str()); break;
+      case BinaryOp::Sub: Emit("subl %s, %%eax", b.c_str()); break;
+      case BinaryOp::Mul: Emit("imull %s, %%eax", b.c_str()); break;
+      case BinaryOp::And: Emit("andl %s, %%eax", b.c_str()); break;
+      case BinaryOp::Or: Emit("orl %s, %%eax", b.c_str()); break;
+      case BinaryOp::Div:
+      case BinaryOp::Mod:
+        Emit("cltd");
+        Emit("idivl %s", b.c_str());
+        if (code == BinaryOp::Mod) Emit("movl %%edx, %%eax");
+        break;
+      default:
+        Assert(compareName[code] != NULL);
+        Emit("cmpl %s, %%eax", b.c_str());
+        Emit("%s %%al", compareName[code]);
+        Emit("movzbl %%al, %%eax");
+        break;
+    }
+    Emit("movl %%eax, %s", Var(dst).c_str());
+}
+
+void X86::EmitLabel(const char *label) {
+    Emit("%s:", Symbol(label));
+}
+
+void X86::EmitGoto(const char *label) {
+    Emit("jmp %s\t\t# unconditional branch", label);
+}
+
+void X86::EmitIfZ(Location *test, const char *label) {
+    Emit("cmpl $0, %s", Var(test).c_str());
+    Emit("je %s\t# branch if %s is zero", label, test->GetName());
+}
+
+void X86::EmitIfNZ(Location *test, const char *label) {
+    Emit("cmpl $0, %s", Var(test).c_str());
+    Emit("jne %s\t# branch if %s is not zero", label, test->GetName());
+}
+
+/* The params are words on the stack, as on MIPS.
+ */
+void X86::EmitParam(Location *arg) {
+    Emit("movl %s, %%eax", Var(arg).c_str());
+    Emit("subq $4, %%rsp\t# decrement sp to make space for param");
+    Emit("movl %%eax, (%%rsp)\t# copy param value to stack");
+}
+
+/* Method: Call
+ * ------------
+ * Calls a built-in function of the runtime with the System V convention.
+ * The params pushed for the call are passed in %edi and %esi, and the
+ * stack is aligned to 16 bytes, with the unaligned %rsp saved on it.
+ */
+void X86::Call(Location *result, const char *fn) {
+    Emit("movq %%rsp, %%rcx");
+    Emit("andq $-16, %%rsp\t# align the stack for the runtime");
+    Emit("subq $16, %%rsp");
+    Emit("movq %%rcx, (%%rsp)");
+    Emit("movl (%%rcx), %%edi");
+    Emit("movl 4(%%rcx), %%esi");
+    Emit("call decaf%s", fn);
+    Emit("movq (%%rsp), %%rsp");
+    if (result != NULL)
+        Emit("movl %%eax, %s\t# copy function return value", Var(result).c_str());
+}
+
+void X86::EmitLCall(Location *result, const char *label) {
+    for (int b = 0; b < NumBuiltIns; b++) {
+        if (!strcmp(label, CodeGenerator::BuiltInLabel((BuiltIn)b))) {
+            Call(result, label);
+            return;
+        }
+    }
+    Emit("call %-15s\t# jump to function", Symbol(label));
+    if (result != NULL)
+        Emit("movl %%eax, %s\t# copy function return value", Var(result).c_str());
+}
+
+void X86::EmitACall(Location *result, Location *fnAddr) {
+    Emit("movl %s, %%ecx", Var(fnAddr).c_str());
+    Emit("call *%%rcx\t\t# jump to function");
+    if (result != NULL)
+        Emit("movl %%eax, %s\t# copy function return value", Var(result).c_str());
+}
+
+void X86::EmitPopParams(int bytes) {
+    if (bytes != 0)
+        Emit("addq $%d, %%rsp\t# pop params off stack", bytes);
+}
+
+void X86::EmitReturn(Location *returnVal) {
+    if (returnVal != NULL)
+        Emit("movl %s, %%eax\t# assign return value into %%eax",
+                Var(returnVal).c_str());
+    Emit("movq %%rbp, %%rsp\t# pop callee frame off stack");
+    Emit("popq %%rbp\t\t# restore saved rbp");
+    Emit("ret\t\t\t# return from function");
+}
+
+/* The locals start 8 bytes below %rbp, as on MIPS, where ra and fp are
+ * saved there.
+ */
+void X86::EmitBeginFunction(int stackFrameSize) {
+    Assert(stackFrameSize >= 0);
+    Emit("pushq %%rbp\t\t# save rbp");
+    Emit("movq %%rsp, %%rbp\t# set up new rbp");
+    Emit("subq $%d, %%rsp\t# make space for locals/temps",
+            stackFrameSize + 8);
+}
+
+void X86::EmitEndFunction() {
+    Emit("# (below handles reaching end of fn body with no explicit return)");
+    EmitReturn(NULL);
+}
+
+void X86::EmitVTable(const char *label, List<const char*> *methodLabels,
+        List<const char*> *itableLabels) {
+    Emit(".data");
+    Emit(".align 4");
+    if (itableLabels) {
+        for (int i = itableLabels->NumElements() - 1; i >= 0; i--) {
+            if (itableLabels->Nth(i))
+                Emit(".long %s\t# interface %d", itableLabels->Nth(i), i);
+            else
+                Emit(".long 0\t# interface %d", i);
+        }
+    }
+    Emit("%s:\t\t# label for class %s vtable", label, label);
+    for (int i = 0; i < methodLabels->NumElements(); i++)
+        Emit(".long %s\n", methodLabels->Nth(i));
+    Emit(".text");
+}
+
+void X86::EmitITable(const char *label, List<const char*> *methodLabels) {
+    Emit(".data");
+    Emit(".align 4");
+    Emit("%s:\t\t# label for interface table %s", label, label);
+    for (int i = 0; i < methodLabels->NumElements(); i++)
+        Emit(".long %s\n", methodLabels->Nth(i));
+    Emit(".text");
+}
+
+void X86::EmitProfileTable(const char *label, const char *function,
+        int numCounters) {
+    Emit(".data");
+    Emit("%s.name: .asciz \"%s\"", label, function);
+    Emit(".align 4");
+    Emit("%s:\t\t# label for profile table of %s", label, function);
+    Emit(".long %s.name, %d", label, numCounters);
+    Emit(".space %d", 4 * numCounters);
+    Emit(".text");
+}
+
+void X86::EmitPreamble() {
+    Emit("# standard Decaf preamble ");
+    Emit(".text");
+    Emit(".align 4");
+    Emit(".globl decaf_main");
+}
+
+/* The global vars are a common block, which is shared with the code of
+ * the libraries, see summary.h.
+ */
+void X86::EmitEpilogue() {
+    if (globalSize > 0)
+        Emit(".comm decaf_globals, %d, 8", globalSize);
+    Emit(".section .note.GNU-stack,\"\",@progbits");
+}
@@ -0,0 +1,86 @@
+/* File: x86.h
+ * -----------
+ * The X86 class emits x86-64 assembly for the GNU assembler, for the
+ * Linux build hosts:
+ *
+ *    dcc prog.decaf --target x86-64 > prog.s
+ *    gcc -no-pie prog.s x86defs.c -o prog
+ *
+ * Like the Mips class, it translates each Tac instruction on its own and
+ * keeps every var in memory: an operand is loaded into %eax or %ecx, and
+ * a result is stored right back. The values are 32-bit words as on MIPS,
+ * so the layout of the frames, the objects and the vtables does not
+ * change. This needs all the addresses stored in vars to fit in 32 bits:
+ * the program is linked at a low address (-no-pie) and the runtime
+ * allocates its heap below 4 GB, see x86defs.c.
+ *
+ * A Decaf function is called as on MIPS, the params are pushed on the
+ * stack as words, the caller pops them, and the result is in %eax. The
+ * frame is set up with %rbp, the Tac offsets of the params are shifted
+ * past the return address and the saved %rbp. The built-in functions are
+ * C functions of x86defs.c, called with the System V convention: the
+ * params are passed in %edi and %esi, on a stack aligned to 16 bytes.
+ * The main function is emitted as decaf_main, called by the main of the
+ * runtime. The global vars are a common block, decaf_globals.
+ *
+ * Author: Deyuan Guo
+ */
+
+#ifndef _H_x86
+#define _H_x86
+
+#include <string>
+#include "target.h"
+
+class X86 : public Target
+{
+  private:
+    int globalSize;                 // the extent of the gp offsets.
+
+    std::string Var(Location *var);
+    static const char *Symbol(const char *label);
+    void Call(Location *result, const char *fn);
+
+    static const char * const compareName[BinaryOp::NumOps];
+
+  public:
+    X86();
+
+    void EmitComment(const char *tac);
+
+    void EmitLoadConstant(Location *dst, int val);
+    void EmitLoadStringConstant(Location *dst, const char *str);
+    void EmitLoadLabel(Location *dst, const char *label);
+
+    void EmitLoad(Location *dst, Location *reference, int offset);
+    void EmitStore(Location *reference, Location *value, int offset);
+    void EmitCopy(Location *dst, Location *src);
+
+    void EmitBinaryOp(BinaryOp::OpCode code, Location *dst,
+            Location *op1, Location *op2);
+
+    void EmitLabel(const char *label);
+    void EmitGoto(const char *label);
+    void EmitIfZ(Location *test, const char*label);
+    void EmitIfNZ(Location *test, const char*label);
+    void EmitReturn(Location *returnVal);
+
+    void EmitBeginFunction(int frameSize);
+    void EmitEndFunction();
+
+    void EmitParam(Location *arg);
+    void EmitLCall(Location *result, const char* label);
+    void EmitACall(Location *result, Location *fnAddr);
+    void EmitPopParams(int bytes);
+
+    void EmitVTable(const char *label, List<const char*> *methodLabels,
+                    List<const char*> *itableLabels = NULL);
+    void EmitITable(const char *label, List<const char*> *methodLabels);
+    void EmitProfileTable(const char *label, const char *function,
+                          int numCounters);
+
+    void EmitPreamble();
+    void EmitEpilogue();
+};
+
+#endif
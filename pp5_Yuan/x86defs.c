@@ -0,0 +1,103 @@
+/* File: x86defs.c
+ * ---------------
+ * The built-in functions of Decaf for the x86-64 target, in the place of
+ * defs.asm (see x86.h). They are called with the System V convention,
+ * and the values are 32-bit words, so the heap is allocated below 4 GB.
+ * The program is linked with this file:
+ *
+ *    gcc -no-pie prog.s x86defs.c -o prog
+ *
+ * Author: Deyuan Guo
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define HeapSize (256 << 20)    /* reserved, only touched pages are used. */
+#define ReadLineSize 128        /* as in defs.asm. */
+
+static char *heap, *heapLimit;
+
+static char *Address(int32_t word) {
+    return (char *)(uintptr_t)(uint32_t)word;
+}
+
+int32_t decaf_Alloc(int32_t size) {
+    if (heap == NULL) {
+        void *p = mmap(NULL, HeapSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE |
+                       MAP_32BIT, -1, 0);
+        if (p == MAP_FAILED) {
+            fprintf(stderr, "Cannot allocate the heap.\n");
+            exit(1);
+        }
+        heap = p;
+        heapLimit = heap + HeapSize;
+    }
+    size_t bytes = ((size_t)(uint32_t)size + 3) & ~(size_t)3;
+    if (size < 0 || bytes > (size_t)(heapLimit - heap)) {
+        fflush(stdout);
+        fprintf(stderr, "Out of memory, cannot allocate %d bytes.\n", size);
+        exit(1);
+    }
+    char *p = heap;
+    heap += bytes;
+    return (int32_t)(uintptr_t)p;
+}
+
+int32_t decaf_ReadLine(void) {
+    int32_t line = decaf_Alloc(ReadLineSize);
+    char *buf = Address(line);
+    fflush(stdout);
+    if (!fgets(buf, ReadLineSize, stdin)) *buf = '\0';
+    size_t len = strlen(buf);
+    if (len > 0 && buf[len - 1] == '\n') buf[len - 1] = '\0';
+    return line;
+}
+
+int32_t decaf_ReadInteger(void) {
+    char line[64];
+    fflush(stdout);
+    return fgets(line, sizeof(line), stdin) ? atoi(line) : 0;
+}
+
+int32_t decaf_StringEqual(int32_t s1, int32_t s2) {
+    return strcmp(Address(s1), Address(s2)) == 0;
+}
+
+void decaf_PrintInt(int32_t n) {
+    printf("%d", n);
+}
+
+void decaf_PrintString(int32_t s) {
+    fputs(Address(s), stdout);
+}
+
+void decaf_PrintBool(int32_t b) {
+    fputs(b > 0 ? "true" : "false", stdout);
+}
+
+void decaf_Halt(void) {
+    exit(0);
+}
+
+/* the tables of the profile counters, see CodeGenerator::Instrument. */
+void decaf_DumpProfile(int32_t dir) {
+    fputs("\n# profile\n", stdout);
+    for (int32_t *t = (int32_t *)Address(dir); *t != 0; t++) {
+        int32_t *table = (int32_t *)Address(*t);
+        for (int i = 0; i < table[1]; i++)
+            printf("%s %d %d\n", Address(table[0]), i, table[2 + i]);
+    }
+}
+
+void decaf_main(void);
+
+int main(void) {
+    decaf_main();
+    return 0;
+}